@@ -26,8 +26,6 @@
 
 #include <cstdlib>
 
-#define HIDE_NODES 1
-
 const int gridSize = 20;
 const int thumbnailSize = 150;
 
@@ -132,67 +130,7 @@ class IconGrid : public QskLinearBox
             for ( int row = 0; row < gridSize; row++ )
                 ( void ) new Thumbnail( randomColor(), randomShape(), this );
         }
-
-#if HIDE_NODES
-        /*
-            When having too many nodes, the scene graph becomes horribly slow.
-            So we explicitely hide all items outside the visible area
-            ( see updateVisibilities below ) and make use of the DeferredUpdate and
-            CleanupOnVisibility features of QskItem.
-         */
-        setSize( sizeConstraint() );
-        updateLayout(); // so that every item has its initial geometry
-
-        for ( int i = 0; i < elementCount(); i++ )
-        {
-            if ( auto control = qskControlCast( itemAtIndex( i ) ) )
-            {
-                // to support the optimizations in ScrollArea::updateVisibilities
-                control->setPlacementPolicy( Qsk::Hidden, QskPlacementPolicy::Reserve );
-                control->setVisible( false );
-            }
-        }
-#endif
-    }
-
-#if HIDE_NODES
-    void updateVisibilities( const QRectF& viewPort )
-    {
-        if ( !isEmpty() && viewPort != m_viewPort )
-        {
-            setItemsVisible( m_viewPort, false );
-            setItemsVisible( viewPort, true );
-
-            m_viewPort = viewPort;
-        }
-    }
-
-  private:
-    void setItemsVisible( const QRectF& rect, bool on )
-    {
-        const auto dim = dimension();
-
-        // we know, that all items have the same size
-        const auto itemSize = itemAtIndex( 0 )->size();
-
-        const int rowMin = rect.top() / ( itemSize.height() + spacing() );
-        const int rowMax = rect.bottom() / ( itemSize.height() + spacing() );
-
-        const int colMin = rect.left() / ( itemSize.width() + spacing() );
-        const int colMax = rect.right() / ( itemSize.height() + spacing() );
-
-        for ( int row = rowMin; row <= rowMax; row++ )
-        {
-            for ( int col = colMin; col <= colMax; col++ )
-            {
-                if ( auto item = itemAtIndex( row * dim + col ) )
-                    item->setVisible( on );
-            }
-        }
     }
-
-    QRectF m_viewPort;
-#endif
 };
 
 class ScrollArea : public QskScrollArea
@@ -219,28 +157,13 @@ class ScrollArea : public QskScrollArea
 
         setFlickRecognizerTimeout( 300 );
 
-        connect( this, &QskScrollView::scrollPosChanged,
-            this, &ScrollArea::updateVisibilities );
-    }
-
-  protected:
-    void geometryChangeEvent( QskGeometryChangeEvent* event ) override
-    {
-        QskScrollArea::geometryChangeEvent( event );
-        updateVisibilities();
-    }
-
-  private:
-    void updateVisibilities()
-    {
-#if HIDE_NODES
-        const auto box = static_cast< IconGrid* >( scrolledItem() );
-        if ( box )
-        {
-            const QRectF viewPort( scrollPos(), viewContentsRect().size() );
-            box->updateVisibilities( viewPort );
-        }
-#endif
+        /*
+            When having too many nodes, the scene graph becomes horribly slow.
+            So we hide all thumbnails outside the visible area and make use of the
+            DeferredUpdate and CleanupOnVisibility features of QskItem.
+         */
+        setItemVirtualization( true );
+        setVirtualizationMargin( thumbnailSize );
     }
 };
 
@@ -262,11 +185,8 @@ int main( int argc, char* argv[] )
         The thumbnails are implemented as buttons, so that we can see if the gesture
         recognition for the flicking works without stopping the buttons from being functional.
 
-        This example also shows, that blocking of the scene graph node creation
-        ( QskControl::DeferredUpdate + QskControl::CleanupOnVisibility )
-        could be improved to also respect being inside the window or a clip region.
-        To have a similar effect with what is possible today, the code
-        explicitely hide/show(s) the buttons out/inside the viewport.
+        The buttons outside of the viewport are hidden by the item virtualization
+        of QskScrollArea, so that no scene graph nodes are created for them.
 
         But here we only want to demonstrate how QskScrollArea works.
      */
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "Benchmark.h"
+
+#include <QskAnchorBox.h>
+#include <QskControl.h>
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+#include <QskWindow.h>
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+/*
+    A form of label/field rows, where each row needs 6 anchors:
+
+        - label: left to the box, top to the previous label
+        - field: left to the label, right to the box,
+                 top/bottom to the label
+
+    Together with the anchor of the last label to the bottom
+    of the box we end up with 6 * 84 + 1 = 505 constraints.
+ */
+
+namespace
+{
+    const int formRowCount = 84;
+    const int resizeCount = 200;
+    const int hintChangeCount = 200;
+
+    class Label : public QskControl
+    {
+      public:
+        Label( QQuickItem* parent = nullptr )
+            : QskControl( parent )
+        {
+            initSizePolicy( QskSizePolicy::Fixed, QskSizePolicy::Preferred );
+
+            setMinimumSize( 120, 20 );
+            setPreferredSize( 120, 30 );
+            setMaximumSize( 120, 60 );
+        }
+    };
+
+    class Field : public QskControl
+    {
+      public:
+        Field( QQuickItem* parent = nullptr )
+            : QskControl( parent )
+        {
+            initSizePolicy( QskSizePolicy::Expanding, QskSizePolicy::Preferred );
+
+            setMinimumSize( 50, 20 );
+            setPreferredSize( 200, 30 );
+            setMaximumSize( 1000, 60 );
+        }
+    };
+
+    class Form
+    {
+      public:
+        virtual ~Form() = default;
+
+        virtual QskControl* box() const = 0;
+        QVector< Field* > fields;
+    };
+
+    class AnchorForm : public Form
+    {
+      public:
+        AnchorForm()
+            : m_box( new QskAnchorBox() )
+        {
+            Label* previousLabel = nullptr;
+
+            for ( int row = 0; row < formRowCount; row++ )
+            {
+                auto label = new Label( m_box );
+                auto field = new Field( m_box );
+
+                m_box->addAnchor( label, Qt::AnchorLeft, Qt::AnchorLeft );
+
+                if ( previousLabel )
+                    m_box->addAnchor( label, Qt::AnchorTop, previousLabel, Qt::AnchorBottom );
+                else
+                    m_box->addAnchor( label, Qt::AnchorTop, Qt::AnchorTop );
+
+                m_box->addAnchor( field, Qt::AnchorLeft, label, Qt::AnchorRight );
+                m_box->addAnchor( field, Qt::AnchorRight, Qt::AnchorRight );
+                m_box->addAnchor( field, Qt::AnchorTop, label, Qt::AnchorTop );
+                m_box->addAnchor( field, Qt::AnchorBottom, label, Qt::AnchorBottom );
+
+                fields += field;
+                previousLabel = label;
+            }
+
+            m_box->addAnchor( previousLabel, Qt::AnchorBottom, Qt::AnchorBottom );
+        }
+
+        QskControl* box() const override { return m_box; }
+
+      private:
+        QskAnchorBox* m_box;
+    };
+
+    class GridForm : public Form
+    {
+      public:
+        GridForm()
+            : m_box( new QskGridBox() )
+        {
+            m_box->setSpacing( 0 );
+
+            for ( int row = 0; row < formRowCount; row++ )
+            {
+                auto field = new Field();
+
+                m_box->addItem( new Label(), row, 0 );
+                m_box->addItem( field, row, 1 );
+
+                fields += field;
+            }
+        }
+
+        QskControl* box() const override { return m_box; }
+
+      private:
+        QskGridBox* m_box;
+    };
+
+    class LinearForm : public Form
+    {
+      public:
+        LinearForm()
+            : m_box( new QskLinearBox( Qt::Vertical ) )
+        {
+            m_box->setSpacing( 0 );
+
+            for ( int row = 0; row < formRowCount; row++ )
+            {
+                auto rowBox = new QskLinearBox( Qt::Horizontal, m_box );
+                rowBox->setSpacing( 0 );
+
+                auto field = new Field();
+
+                rowBox->addItem( new Label() );
+                rowBox->addItem( field );
+
+                fields += field;
+            }
+        }
+
+        QskControl* box() const override { return m_box; }
+
+      private:
+        QskLinearBox* m_box;
+    };
+
+    template< typename T >
+    void benchmark( const char* name )
+    {
+        QskWindow window;
+        window.setAutoLayoutChildren( false );
+
+        QElapsedTimer timer;
+        timer.start();
+
+        T form;
+        auto box = form.box();
+
+        window.addItem( box );
+
+        const auto hint = box->effectiveSizeHint( Qt::PreferredSize );
+        box->setGeometry( QRectF( QPointF(), hint ) );
+        window.polishItems();
+
+        const auto setupTime = timer.nsecsElapsed();
+
+        timer.restart();
+
+        for ( int i = 0; i < resizeCount; i++ )
+        {
+            const qreal f = 1.0 + 0.5 * ( i % 10 ) / 10.0;
+            box->setSize( QSizeF( f * hint.width(), f * hint.height() ) );
+
+            window.polishItems();
+        }
+
+        const auto resizeTime = timer.nsecsElapsed();
+
+        timer.restart();
+
+        for ( int i = 0; i < hintChangeCount; i++ )
+        {
+            auto field = form.fields[ i % form.fields.size() ];
+            field->setPreferredHeight( ( i % 2 ) ? 30 : 40 );
+
+            box->setSize( box->effectiveSizeHint( Qt::PreferredSize ) );
+            window.polishItems();
+        }
+
+        const auto hintChangeTime = timer.nsecsElapsed();
+
+        qDebug() << name
+            << "setup:" << setupTime / 1e6 << "ms"
+            << "resize:" << resizeTime / 1e3 / resizeCount << "us"
+            << "hint change:" << hintChangeTime / 1e3 / hintChangeCount << "us";
+    }
+}
+
+void runBenchmark()
+{
+    qDebug() << "Form with" << formRowCount << "rows"
+        << "-" << 6 * formRowCount + 1 << "anchors";
+
+    benchmark< AnchorForm >( "QskAnchorBox:" );
+    benchmark< GridForm >( "QskGridBox:" );
+    benchmark< LinearForm >( "QskLinearBox:" );
+}
@@ -0,0 +1,12 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#pragma once
+
+/*
+    Compares a form with ~500 anchors in a QskAnchorBox with
+    the equivalent layouts of a QskGridBox and nested QskLinearBoxes.
+ */
+void runBenchmark();
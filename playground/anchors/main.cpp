@@ -3,10 +3,11 @@
  *           SPDX-License-Identifier: BSD-3-Clause
  *****************************************************************************/
 
-#include "AnchorBox.h"
+#include "Benchmark.h"
 
 #include <SkinnyShortcut.h>
 
+#include <QskAnchorBox.h>
 #include <QskControl.h>
 #include <QskObjectCounter.h>
 #include <QskWindow.h>
@@ -46,11 +47,11 @@ class TestRectangle : public QskControl
 };
 
 
-class MyBox : public AnchorBox
+class MyBox : public QskAnchorBox
 {
   public:
     MyBox( QQuickItem* parent = nullptr )
-        : AnchorBox( parent )
+        : QskAnchorBox( parent )
     {
         setObjectName( "Box" );
         setup1();
@@ -63,7 +64,7 @@ class MyBox : public AnchorBox
   protected:
     virtual void geometryChangeEvent( QskGeometryChangeEvent* event ) override
     {
-        AnchorBox::geometryChangeEvent( event );
+        QskAnchorBox::geometryChangeEvent( event );
     }
 };
 
@@ -152,6 +153,12 @@ int main( int argc, char* argv[] )
 
     QGuiApplication app( argc, argv );
 
+    if ( app.arguments().contains( "--benchmark" ) )
+    {
+        runBenchmark();
+        return 0;
+    }
+
     SkinnyShortcut::enable( SkinnyShortcut::Quit | SkinnyShortcut::DebugShortcuts );
 
     auto box = new MyBox();
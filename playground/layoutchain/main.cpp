@@ -0,0 +1,221 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Comparing QskLayoutChain with the previous implementation, that
+    was stopping to sum up the maximum at the first unlimited cell:
+
+        - finish(): calculating the bounding metrics
+        - distributed(): size <= minimum, or size > maximum
+        - minimumExpanded(): minimum < size < preferred
+        - preferredStretched(): preferred <= size <= maximum
+
+    for chains with 10 - 10000 cells.
+ */
+
+#include "LegacyLayoutChain.h"
+
+#include <QskLayoutChain.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QDebug>
+
+#include <cmath>
+
+namespace
+{
+    const int cellCounts[] = { 10, 100, 1000, 10000 };
+
+    // the number of processed cells for each measurement
+    const int cellsPerRun = 2000000;
+
+    class Cell
+    {
+      public:
+        qreal minimum;
+        qreal preferred;
+        qreal maximum;
+        int stretch;
+        bool canGrow;
+        bool isValid;
+    };
+
+    QVector< Cell > createCells( int count, bool stretches )
+    {
+        QRandomGenerator generator( count );
+
+        QVector< Cell > cells;
+        cells.reserve( count );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            Cell cell;
+
+            cell.minimum = generator.bounded( 50 );
+            cell.preferred = cell.minimum + generator.bounded( 50 );
+            cell.maximum = cell.preferred + generator.bounded( 100 );
+            cell.stretch = stretches ? generator.bounded( 3 ) : 0;
+            cell.canGrow = generator.bounded( 2 );
+            cell.isValid = generator.bounded( 10 ) != 0;
+
+            cells += cell;
+        }
+
+        return cells;
+    }
+
+    template< typename Chain >
+    void setupChain( Chain& chain, const QVector< Cell >& cells )
+    {
+        chain.reset( cells.size(), -1.0 );
+        chain.setSpacing( 5.0 );
+
+        for ( int i = 0; i < cells.size(); i++ )
+        {
+            const auto& cell = cells[i];
+
+            typename Chain::CellData cellData;
+            cellData.isValid = cell.isValid;
+            cellData.canGrow = cell.canGrow;
+            cellData.stretch = cell.stretch;
+            cellData.metrics = QskLayoutMetrics(
+                cell.minimum, cell.preferred, cell.maximum );
+
+            chain.expandCell( i, cellData );
+        }
+
+        chain.finish();
+    }
+
+    volatile qreal sink = 0.0;
+
+    template< typename Chain >
+    qreal nsecsFinish( Chain& chain, int runs )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < runs; i++ )
+        {
+            chain.finish();
+            sink = chain.boundingMetrics().maximum();
+        }
+
+        return qreal( timer.nsecsElapsed() ) / runs;
+    }
+
+    template< typename Chain >
+    qreal nsecsSegments( const Chain& chain, qreal size, int runs )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < runs; i++ )
+        {
+            const auto segments = chain.segments( size );
+            if ( !segments.isEmpty() )
+                sink = segments.last().end();
+        }
+
+        return qreal( timer.nsecsElapsed() ) / runs;
+    }
+
+    template< typename Chain1, typename Chain2 >
+    bool isEqual( const Chain1& chain1, const Chain2& chain2, qreal size )
+    {
+        const auto segments1 = chain1.segments( size );
+        const auto segments2 = chain2.segments( size );
+
+        if ( segments1.size() != segments2.size() )
+            return false;
+
+        for ( int i = 0; i < segments1.size(); i++ )
+        {
+            const auto& s1 = segments1[i];
+            const auto& s2 = segments2[i];
+
+            const qreal tolerance = 1e-6 * qMax( qreal( 1.0 ), std::abs( s1.end() ) );
+
+            if ( std::abs( s1.start - s2.start ) > tolerance
+                || std::abs( s1.length - s2.length ) > tolerance )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void report( const char* name, qreal legacy, qreal current )
+    {
+        qDebug().nospace() << "    " << name << ": "
+            << legacy << "ns -> " << current << "ns ( x"
+            << legacy / current << " )";
+    }
+
+    void benchmark( int count, bool stretches )
+    {
+        const auto cells = createCells( count, stretches );
+
+        LegacyLayoutChain legacyChain;
+        setupChain( legacyChain, cells );
+
+        QskLayoutChain chain;
+        setupChain( chain, cells );
+
+        const auto metrics = chain.boundingMetrics();
+
+        const qreal sizes[] =
+        {
+            0.5 * metrics.minimum(),
+            0.5 * ( metrics.minimum() + metrics.preferred() ),
+            0.5 * ( metrics.preferred() + metrics.maximum() ),
+            1.5 * metrics.maximum()
+        };
+
+        const char* names[] =
+        {
+            "distributed( Minimum )",
+            "minimumExpanded",
+            "preferredStretched",
+            "distributed( Maximum )"
+        };
+
+        qDebug().nospace() << count << " cells"
+            << ( stretches ? ", with stretch factors" : "" );
+
+        for ( const auto size : sizes )
+        {
+            if ( !isEqual( legacyChain, chain, size ) )
+                qWarning() << "    Different segments for size:" << size;
+        }
+
+        const int runs = qMax( 1, cellsPerRun / count );
+
+        report( "finish", nsecsFinish( legacyChain, runs ),
+            nsecsFinish( chain, runs ) );
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            report( names[i], nsecsSegments( legacyChain, sizes[i], runs ),
+                nsecsSegments( chain, sizes[i], runs ) );
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    for ( const auto count : cellCounts )
+    {
+        benchmark( count, false );
+        benchmark( count, true );
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Flinging through a list of 1M rows to measure the costs of
+    mapping scroll positions to rows and of recycling the cell nodes.
+
+        listview [--uniform]
+
+    By default the rows have different heights, what is resolved
+    from the Fenwick tree of QskListView. With --uniform all rows
+    have the same height and the arithmetic path is used.
+
+    The scroll position is advanced by several screens per frame,
+    so that almost all visible rows are replaced in every frame.
+    Frame times are reported once per second and summarized at the end.
+ */
+
+#include <QskAnimator.h>
+#include <QskListView.h>
+#include <QskWindow.h>
+
+#include <SkinnyShortcut.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QDebug>
+
+#include <atomic>
+#include <functional>
+
+namespace
+{
+    const int listRowCount = 1000000;
+
+    class ListView : public QskListView
+    {
+      public:
+        ListView( bool uniform )
+        {
+            setVariableRowHeights( !uniform );
+            updateScrollableSize();
+        }
+
+        int rowCount() const override { return listRowCount; }
+        int columnCount() const override { return 1; }
+
+        qreal columnWidth( int ) const override { return 400.0; }
+        qreal rowHeight() const override { return 30.0; }
+
+        qreal rowHeightAt( int row ) const override
+        {
+            // mixing single and multi line rows
+            return 24.0 + ( ( row * 7919 ) % 5 ) * 12.0;
+        }
+
+        QVariant valueAt( int row, int ) const override
+        {
+            return QStringLiteral( "Row %1" ).arg( row );
+        }
+    };
+
+    class Fling : public QskAnimator
+    {
+      public:
+        Fling( ListView* listView )
+            : m_listView( listView )
+        {
+            setDuration( 20000 );
+        }
+
+        std::function< void() > onDone;
+
+      protected:
+        void advance( qreal value ) override
+        {
+            const auto range = m_listView->scrollableSize().height()
+                - m_listView->viewContentsRect().height();
+
+            m_listView->setScrollPos( QPointF( 0.0, value * range ) );
+        }
+
+        void done() override
+        {
+            if ( onDone )
+                onDone();
+        }
+
+      private:
+        ListView* m_listView;
+    };
+
+    class FrameStatistics
+    {
+      public:
+        void addFrame( qint64 nsecs )
+        {
+            frames++;
+            totalTime += nsecs;
+
+            auto max = maximumTime.load();
+            while ( nsecs > max && !maximumTime.compare_exchange_weak( max, nsecs ) )
+                ;
+        }
+
+        void reset()
+        {
+            frames = 0;
+            totalTime = 0;
+            maximumTime = 0;
+        }
+
+        void dump( const char* title ) const
+        {
+            const int n = frames.load();
+
+            qDebug() << title << "frames:" << n
+                << "avg:" << ( n ? totalTime.load() / n / 1e6 : 0.0 ) << "ms"
+                << "max:" << maximumTime.load() / 1e6 << "ms";
+        }
+
+        std::atomic< int > frames { 0 };
+        std::atomic< qint64 > totalTime { 0 };
+        std::atomic< qint64 > maximumTime { 0 };
+    };
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    SkinnyShortcut::enable( SkinnyShortcut::AllShortcuts );
+
+    const bool uniform = app.arguments().contains( "--uniform" );
+
+    auto listView = new ListView( uniform );
+
+    QskWindow window;
+    window.addItem( listView );
+    window.resize( 400, 800 );
+
+    FrameStatistics seconds;
+    FrameStatistics total;
+
+    QElapsedTimer frameTimer;
+
+    QObject::connect( &window, &QQuickWindow::frameSwapped, &window,
+        [ & ]()
+        {
+            if ( frameTimer.isValid() )
+            {
+                const auto elapsed = frameTimer.nsecsElapsed();
+
+                seconds.addFrame( elapsed );
+                total.addFrame( elapsed );
+            }
+
+            frameTimer.start();
+        },
+        Qt::DirectConnection );
+
+    QTimer reportTimer;
+    reportTimer.setInterval( 1000 );
+
+    QObject::connect( &reportTimer, &QTimer::timeout,
+        [ & ]()
+        {
+            seconds.dump( uniform ? "Uniform:" : "Variable:" );
+            seconds.reset();
+        } );
+
+    Fling fling( listView );
+    fling.setWindow( &window );
+
+    fling.onDone = [ & ]()
+    {
+        total.dump( "Total:" );
+        app.quit();
+    };
+
+    window.show();
+
+    // starting, when the window is exposed
+    QTimer::singleShot( 500, [ & ]() { frameTimer.invalidate(); fling.start(); } );
+    reportTimer.start();
+
+    return app.exec();
+}
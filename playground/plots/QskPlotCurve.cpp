@@ -21,6 +21,11 @@ QskPlotCurve::QskPlotCurve( QObject* object )
     : Inherited( object )
     , m_data( new PrivateData )
 {
+    /*
+        The curve is stroked in canvas coordinates, so that the
+        line width is not affected by the scales.
+     */
+    setCoordinateType( CanvasCoordinates );
 }
 
 QskPlotCurve::~QskPlotCurve()
@@ -8,112 +8,76 @@
 #include "QskPlotCurve.h"
 
 #include <QskSGNode.h>
-#include <QskVertex.h>
+#include <QskStrokeNode.h>
 
-#include <qsggeometry.h>
-#include <qsgvertexcolormaterial.h>
+#include <qpainterpath.h>
+#include <qpen.h>
 
-namespace
+static QPainterPath qskCurvePath(
+    const QRectF& scaleRect, const QskPlotCurveData* data )
 {
-    class CurveNode : public QSGGeometryNode
+    int from = 0;
+    int to = data->count() - 1;
+
+    auto point1 = data->pointAt( from );
+    auto point2 = data->pointAt( to );
+
+    if ( data->hints() & QskPlotCurveData::MonotonicX )
+    {
+        const qreal x1 = scaleRect.left();
+        const qreal x2 = scaleRect.right();
+
+        if ( x1 > point2.x() || x2 < point1.x() )
+            return QPainterPath();
+
+        const int index1 = data->upperIndex( Qt::Horizontal, x1 );
+        if ( index1 > 0 )
+        {
+            from = index1 - 1;
+            point1 = data->interpolatedPoint( Qt::Horizontal, x1 );
+        }
+
+        const int index2 = data->upperIndex( Qt::Horizontal, x2 );
+        if ( index2 > 0 )
+        {
+            to = index2;
+            point2 = data->interpolatedPoint( Qt::Horizontal, x2 );
+        }
+    }
+    else if ( data->hints() & QskPlotCurveData::MonotonicY )
     {
-      public:
-        CurveNode()
-            : m_geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
+        const qreal y1 = scaleRect.top();
+        const qreal y2 = scaleRect.bottom();
+
+        if ( y1 > point2.y() || y2 < point1.y() )
+            return QPainterPath();
+
+        const int index1 = data->upperIndex( Qt::Vertical, y1 );
+        if ( index1 > 0 )
         {
-            setGeometry( &m_geometry );
-            setMaterial( &m_material );
+            from = index1 - 1;
+            point1 = data->interpolatedPoint( Qt::Vertical, y1 );
         }
 
-        void updateCurve( const QRectF& scaleRect, const QskPlotCurveData* data,
-            const QColor& color, qreal lineWidth )
+        const int index2 = data->upperIndex( Qt::Vertical, y2 );
+        if ( index2 > 0 )
         {
-            m_geometry.setDrawingMode( QSGGeometry::DrawLineStrip );
-
-            const float lineWidthF = lineWidth;
-            if( lineWidthF != m_geometry.lineWidth() )
-                m_geometry.setLineWidth( lineWidthF );
-
-            const QskVertex::Color c( color );
-
-            int from = 0;
-            int to = data->count() - 1;
-
-            auto point1 = data->pointAt( from );
-            auto point2 = data->pointAt( to );
-
-            if ( data->hints() & QskPlotCurveData::MonotonicX )
-            {
-                const qreal x1 = scaleRect.left();
-                const qreal x2 = scaleRect.right();
-
-                if ( x1 > point2.x() || x2 < point1.x() )
-                {
-                    QskSGNode::resetGeometry( this );
-                    return;
-                }
-
-                const int index1 = data->upperIndex( Qt::Horizontal, x1 );
-                if ( index1 > 0 )
-                {
-                    from = index1 - 1;
-                    point1 = data->interpolatedPoint( Qt::Horizontal, x1 );
-                }
-
-                const int index2 = data->upperIndex( Qt::Horizontal, x2 );
-                if ( index2 > 0 )
-                {
-                    to = index2;
-                    point2 = data->interpolatedPoint( Qt::Horizontal, x2 );
-                }
-            }
-            else if ( data->hints() & QskPlotCurveData::MonotonicY )
-            {
-                const qreal y1 = scaleRect.top();
-                const qreal y2 = scaleRect.bottom();
-
-                if ( y1 > point2.y() || y2 < point1.y() )
-                {
-                    QskSGNode::resetGeometry( this );
-                    return;
-                }
-
-                const int index1 = data->upperIndex( Qt::Vertical, y1 );
-                if ( index1 > 0 )
-                {
-                    from = index1 - 1;
-                    point1 = data->interpolatedPoint( Qt::Vertical, y1 );
-                }
-
-                const int index2 = data->upperIndex( Qt::Vertical, y2 );
-                if ( index2 > 0 )
-                {
-                    to = index2;
-                    point2 = data->interpolatedPoint( Qt::Vertical, y2 );
-                }
-            }
-
-            m_geometry.allocate( to - from + 1 );
-
-            auto p = m_geometry.vertexDataAsColoredPoint2D();
-
-            p++->set( point1.x(), point1.y(), c.r, c.g, c.b, c.a );
-
-            for ( int i = from + 1; i < to; i++ )
-            {
-                const auto point = data->pointAt( i );
-                p++->set( point.x(), point.y(), c.r, c.g, c.b, c.a );
-            }
-
-            p++->set( point2.x(), point2.y(), c.r, c.g, c.b, c.a );
-
-            markDirty( QSGNode::DirtyGeometry );
+            to = index2;
+            point2 = data->interpolatedPoint( Qt::Vertical, y2 );
         }
+    }
+
+    QPainterPath path;
+    path.reserve( to - from + 1 );
+
+    path.moveTo( point1 );
+
+    for ( int i = from + 1; i < to; i++ )
+        path.lineTo( data->pointAt( i ) );
+
+    path.lineTo( point2 );
 
-      private:
-        QSGGeometry m_geometry;
-        QSGVertexColorMaterial m_material;
-    };
+    return path;
 }
 
 QskPlotCurveSkinlet::QskPlotCurveSkinlet( QskSkin* skin )
@@ -154,8 +118,22 @@ QSGNode* QskPlotCurveSkinlet::updatePolygonNode(
     if ( lineWidth <= 0.0 )
         return nullptr;
 
-    auto curveNode = QskSGNode::ensureNode< CurveNode >( node );
-    curveNode->updateCurve( curve->scaleRect(), curveData, color, lineWidth );
+    /*
+        The path is in plot coordinates, while the stroke is done in
+        canvas coordinates - see QskPlotCurve::QskPlotCurve. A growing
+        curve, that is monotonic in x direction, usually has an unmodified
+        beginning, so that only the new segments need to be stroked.
+     */
+    const auto path = qskCurvePath( curve->scaleRect(), curveData );
+
+    QPen pen( color, lineWidth );
+    pen.setCosmetic( true );
+    pen.setCapStyle( Qt::FlatCap );
+
+    auto curveNode = QskSGNode::ensureNode< QskStrokeNode >( node );
+    curveNode->setAppendOnly(
+        curveData->hints().testFlag( QskPlotCurveData::MonotonicX ) );
+    curveNode->updatePath( path, curve->transformation(), pen );
 
     return curveNode;
 }
@@ -0,0 +1,196 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Animating the size of 1000 rounded boxes to compare the vertex
+    tessellation of QskBoxRectangleNode with QskBoxDistanceFieldNode.
+
+        roundedboxes [--distance-field]
+
+    Frame times, number of vertices and the geometry statistics of
+    QskBoxRectangleNode are reported once per second.
+ */
+
+#include <QskAnimator.h>
+#include <QskBox.h>
+#include <QskBoxBorderColors.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskBoxDistanceFieldNode.h>
+#include <QskBoxRectangleNode.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskGradient.h>
+#include <QskQuick.h>
+#include <QskWindow.h>
+
+#include <SkinnyShortcut.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QSGGeometryNode>
+#include <QTimer>
+#include <QtMath>
+
+#include <atomic>
+
+namespace
+{
+    const int columnCount = 40;
+    const int rowCount = 25;
+
+    const qreal cellWidth = 30.0;
+    const qreal cellHeight = 30.0;
+
+    class Box : public QskBox
+    {
+      public:
+        Box( QQuickItem* parentItem )
+            : QskBox( true, parentItem )
+        {
+            setBoxShapeHint( Panel, 8 );
+            setBoxBorderMetricsHint( Panel, 2 );
+            setBoxBorderColorsHint( Panel, Qt::darkBlue );
+            setGradientHint( Panel, QskGradient( Qt::yellow, Qt::cyan ) );
+        }
+    };
+
+    class Animator : public QskAnimator
+    {
+      public:
+        Animator( const QVector< Box* >& boxes )
+            : m_boxes( boxes )
+        {
+            setDuration( 2000 );
+            setAutoRepeat( true );
+        }
+
+      protected:
+        void advance( qreal value ) override
+        {
+            for ( int i = 0; i < m_boxes.size(); i++ )
+            {
+                const qreal phase = 2.0 * M_PI * ( value + qreal( i ) / m_boxes.size() );
+                const qreal f = 0.6 + 0.4 * qAbs( qSin( phase ) );
+
+                m_boxes[ i ]->setSize( QSizeF( f * cellWidth, f * cellHeight ) );
+            }
+        }
+
+      private:
+        const QVector< Box* > m_boxes;
+    };
+
+    class Statistics
+    {
+      public:
+        std::atomic< int > frames { 0 };
+        std::atomic< qint64 > frameTime { 0 };
+        std::atomic< int > vertices { 0 };
+    };
+
+    int qskVertexCount( const QSGNode* node )
+    {
+        int count = 0;
+
+        if ( node->type() == QSGNode::GeometryNodeType )
+        {
+            const auto geometryNode = static_cast< const QSGGeometryNode* >( node );
+            if ( const auto geometry = geometryNode->geometry() )
+                count += geometry->vertexCount();
+        }
+
+        for ( auto child = node->firstChild(); child; child = child->nextSibling() )
+            count += qskVertexCount( child );
+
+        return count;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const bool distanceField = app.arguments().contains( "--distance-field" );
+    QskBoxDistanceFieldNode::setPreferred( distanceField );
+
+    SkinnyShortcut::enable( SkinnyShortcut::AllShortcuts );
+
+    QskWindow window;
+    window.resize( columnCount * cellWidth, rowCount * cellHeight );
+
+    QVector< Box* > boxes;
+    boxes.reserve( columnCount * rowCount );
+
+    for ( int row = 0; row < rowCount; row++ )
+    {
+        for ( int col = 0; col < columnCount; col++ )
+        {
+            auto box = new Box( window.contentItem() );
+            box->setPosition( QPointF( col * cellWidth, row * cellHeight ) );
+            box->setSize( QSizeF( cellWidth, cellHeight ) );
+
+            boxes += box;
+        }
+    }
+
+    Statistics statistics;
+
+    // the GUI thread is blocked, while the scene graph is synchronized
+    QObject::connect( &window, &QQuickWindow::afterSynchronizing, &window,
+        [ &boxes, &statistics ]()
+        {
+            int count = 0;
+
+            for ( const auto box : std::as_const( boxes ) )
+            {
+                if ( const auto node = qskPaintNode( box ) )
+                    count += qskVertexCount( node );
+            }
+
+            statistics.vertices = count;
+        },
+        Qt::DirectConnection );
+
+    QElapsedTimer frameTimer;
+
+    QObject::connect( &window, &QQuickWindow::frameSwapped, &window,
+        [ &frameTimer, &statistics ]()
+        {
+            if ( frameTimer.isValid() )
+            {
+                statistics.frames++;
+                statistics.frameTime += frameTimer.nsecsElapsed();
+            }
+
+            frameTimer.start();
+        },
+        Qt::DirectConnection );
+
+    QTimer reportTimer;
+    reportTimer.setInterval( 1000 );
+
+    QObject::connect( &reportTimer, &QTimer::timeout,
+        [ distanceField, &statistics ]()
+        {
+            const int frames = statistics.frames.exchange( 0 );
+            const qint64 frameTime = statistics.frameTime.exchange( 0 );
+
+            qDebug() << ( distanceField ? "DistanceField:" : "Tessellation:" )
+                << "frames:" << frames
+                << "avg frame time:" << ( frames ? frameTime / frames / 1e6 : 0.0 ) << "ms"
+                << "vertices:" << statistics.vertices.load()
+                << QskBoxRectangleNode::geometryStatistics();
+
+            QskBoxRectangleNode::resetGeometryStatistics();
+        } );
+
+    Animator animator( boxes );
+    animator.setWindow( &window );
+    animator.start();
+
+    reportTimer.start();
+    window.show();
+
+    return app.exec();
+}
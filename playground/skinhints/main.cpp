@@ -0,0 +1,159 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Comparing the lookups of QskSkinHintTable::resolvedHint with and
+    without the compiled data of QskSkinHintTable::compile.
+
+        skinhints [skinName]
+
+    The queries are built from the aspects of the skin with random
+    combinations of the states and variations, that appear in the table.
+    So most lookups have to go through the fallback chain.
+ */
+
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskSkinHintTable.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QDebug>
+
+namespace
+{
+    const int queryCount = 200000;
+    const int rounds = 20;
+
+    QVector< QskAspect > createQueries( const QskSkinHintTable& table )
+    {
+        QVector< QskAspect > stems;
+        QVector< QskAspect::States > states = { QskAspect::NoState };
+        QVector< QskAspect::Variation > variations = { QskAspect::NoVariation };
+
+        const auto& hints = table.hints();
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            auto stem = it.key().stateless();
+            stem.setVariation( QskAspect::NoVariation );
+
+            stems += stem;
+
+            if ( !states.contains( it.key().states() ) )
+                states += it.key().states();
+
+            if ( !variations.contains( it.key().variation() ) )
+                variations += it.key().variation();
+        }
+
+        QRandomGenerator generator( 42 );
+
+        QVector< QskAspect > queries;
+        queries.reserve( queryCount );
+
+        for ( int i = 0; i < queryCount; i++ )
+        {
+            auto aspect = stems[ generator.bounded( stems.size() ) ];
+
+            aspect.setStates( states[ generator.bounded( states.size() ) ]
+                | states[ generator.bounded( states.size() ) ] );
+
+            aspect.setVariation( variations[ generator.bounded( variations.size() ) ] );
+
+            queries += aspect;
+        }
+
+        return queries;
+    }
+
+    qint64 benchmark( const QskSkinHintTable& table,
+        const QVector< QskAspect >& queries, quintptr& checksum )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < rounds; i++ )
+        {
+            for ( const auto aspect : queries )
+                checksum += reinterpret_cast< quintptr >( table.resolvedHint( aspect ) );
+        }
+
+        return timer.nsecsElapsed();
+    }
+
+    bool verify( const QskSkinHintTable& table1,
+        const QskSkinHintTable& table2, const QVector< QskAspect >& queries )
+    {
+        for ( const auto aspect : queries )
+        {
+            QskAspect a1, a2;
+
+            const auto v1 = table1.resolvedHint( aspect, &a1 );
+            const auto v2 = table2.resolvedHint( aspect, &a2 );
+
+            if ( ( v1 == nullptr ) != ( v2 == nullptr ) || a1 != a2 )
+            {
+                qWarning() << "Mismatch:" << aspect << a1 << a2;
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    if ( app.arguments().size() > 1 )
+        qskSkinManager->setSkin( app.arguments().at( 1 ) );
+
+    const auto skin = qskSkinManager->skin();
+    if ( skin == nullptr )
+    {
+        qWarning() << "No skin available";
+        return 1;
+    }
+
+    // a table without compiled data, as modifications drop it
+
+    QskSkinHintTable hashTable;
+
+    const auto& hints = skin->hintTable().hints();
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        hashTable.setHint( it.key(), it.value() );
+
+    QskSkinHintTable compiledTable( hashTable );
+    compiledTable.compile();
+
+    const auto queries = createQueries( hashTable );
+
+    if ( !verify( hashTable, compiledTable, queries ) )
+        return 1;
+
+    quintptr checksum1 = 0;
+    quintptr checksum2 = 0;
+
+    // warming up
+    benchmark( hashTable, queries, checksum1 );
+    benchmark( compiledTable, queries, checksum2 );
+
+    const auto hashTime = benchmark( hashTable, queries, checksum1 );
+    const auto compiledTime = benchmark( compiledTable, queries, checksum2 );
+
+    const qreal lookups = qreal( queryCount ) * rounds;
+
+    qDebug() << qskSkinManager->skinName()
+        << "hints:" << hints.size() << "lookups:" << lookups;
+
+    qDebug() << "  QHash:   " << hashTime / lookups << "ns/lookup";
+    qDebug() << "  Compiled:" << compiledTime / lookups << "ns/lookup"
+        << "speedup:" << qreal( hashTime ) / qMax( compiledTime, qint64( 1 ) );
+
+    // avoiding, that the lookups are optimized away
+    return ( checksum1 == 1 && checksum2 == 1 ) ? 2 : 0;
+}
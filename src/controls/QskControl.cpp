@@ -8,6 +8,7 @@
 
 #include "QskAspect.h"
 #include "QskFunctions.h"
+#include "QskLayoutProfiler.h"
 #include "QskEvent.h"
 #include "QskQuick.h"
 #include "QskSetup.h"
@@ -16,10 +17,13 @@
 #include "QskSkinHintTable.h"
 #include "QskMargins.h"
 #include "QskTreeNode.h"
+#include "QskWindow.h"
 
 #include <qlocale.h>
 #include <qvector.h>
 
+extern QskPolishStatistics* qskPolishStatistics( QQuickWindow* );
+
 QSK_SUBCONTROL( QskControl, Background )
 
 QSK_SYSTEM_STATE( QskControl, Disabled, QskAspect::FirstSystemState )
@@ -600,7 +604,7 @@ QSizeF QskControl::implicitSizeHint(
     }
     else
     {
-        hint = d_func()->implicitSizeHint( whichHint, constraint );
+        hint = d_func()->cachedImplicitSizeHint( whichHint, constraint );
     }
 
     return hint;
@@ -620,6 +624,9 @@ QSizeF QskControl::effectiveSizeHint(
 
     Q_D( const QskControl );
 
+    if ( auto statistics = qskPolishStatistics( d->window ) )
+        statistics->sizeHints++;
+
     d->blockLayoutRequestEvents = false;
 
     QSizeF hint;
@@ -731,6 +738,8 @@ bool QskControl::event( QEvent* event )
         }
         case QEvent::LayoutRequest:
         {
+            d_func()->invalidateSizeHints();
+
             if ( d_func()->autoLayoutChildren )
             {
                 resetImplicitSize();
@@ -920,6 +929,10 @@ void QskControl::updateItemPolish()
             }
         }
 
+        if ( auto statistics = qskPolishStatistics( window() ) )
+            statistics->layouts++;
+
+        const QskLayoutProfiler::Scope scope( QskLayoutProfiler::UpdateLayout, this );
         updateLayout();
     }
 }
@@ -975,6 +988,7 @@ void QskControl::updateResources()
 QSizeF QskControl::contentsSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
+    const QskLayoutProfiler::Scope scope( QskLayoutProfiler::SkinletSizeHint, this );
     return effectiveSkinlet()->sizeHint( this, which, constraint );
 }
 
@@ -14,11 +14,32 @@
 #include "QskPlacementPolicy.h"
 
 #include <qlocale.h>
+#include <qhash.h>
 #include <memory>
 
 class QskControlPrivate;
 class QskGestureEvent;
 
+class QSK_EXPORT QskSizeHintCacheStatistics
+{
+  public:
+    inline qreal hitRate() const
+    {
+        const auto total = hits + misses;
+        return ( total > 0 ) ? qreal( hits ) / total : 0.0;
+    }
+
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskSizeHintCacheStatistics& );
+
+#endif
+
 class QSK_EXPORT QskControl : public QskItem, public QskSkinnable
 {
     Q_OBJECT
@@ -157,6 +178,16 @@ class QSK_EXPORT QskControl : public QskItem, public QskSkinnable
     QSizeF sizeConstraint( Qt::SizeHint, const QSizeF& constraint = QSizeF() ) const;
     QSizeF sizeConstraint() const;
 
+    /*
+        Statistics about cached size hints by class name. Counting
+        is disabled by default and has to be enabled explicitly.
+     */
+    static void setSizeHintCacheStatisticsEnabled( bool );
+    static bool isSizeHintCacheStatisticsEnabled();
+
+    static QHash< QByteArray, QskSizeHintCacheStatistics > sizeHintCacheStatistics();
+    static void resetSizeHintCacheStatistics();
+
     QLocale locale() const;
     void resetLocale();
 
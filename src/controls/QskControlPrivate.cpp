@@ -5,11 +5,17 @@
 
 #include "QskControlPrivate.h"
 #include "QskSetup.h"
+#include "QskLayoutProfiler.h"
 #include "QskLayoutMetrics.h"
 #include "QskObjectTree.h"
 #include "QskWindow.h"
 #include "QskEvent.h"
 
+#include <qdebug.h>
+#include <qmutex.h>
+
+#include <atomic>
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -118,6 +124,88 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
     QskObjectTree::traverseDown( control, visitor );
 }
 
+/*
+    Counting is disabled by default, as the lookups would eat
+    a good part of what is saved by the cache.
+ */
+static std::atomic< bool > qskSizeHintCacheStatisticsEnabled( false );
+
+static QMutex qskSizeHintCacheStatisticsMutex;
+static QHash< const QMetaObject*, QskSizeHintCacheStatistics > qskSizeHintCacheStatistics;
+
+static inline void qskCountSizeHintLookup( const QMetaObject* metaObject, bool hit )
+{
+    if ( !qskSizeHintCacheStatisticsEnabled.load( std::memory_order_relaxed ) )
+        return;
+
+    QMutexLocker locker( &qskSizeHintCacheStatisticsMutex );
+
+    auto& statistics = qskSizeHintCacheStatistics[ metaObject ];
+    if ( hit )
+        statistics.hits++;
+    else
+        statistics.misses++;
+}
+
+/*
+    Layout engines ask for the same constrained hints several times
+    during a layout pass. As the calculation might be expensive
+    ( f.e. wrapped texts ) we remember the most recent results
+    until resetImplicitSize() or a change of the layout constraints.
+ */
+class QskControlPrivate::SizeHintCache
+{
+  public:
+    bool find( Qt::SizeHint which, const QSizeF& constraint, QSizeF& hint ) const
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            const auto& entry = entries[ i ];
+
+            if ( entry.which == which && entry.constraint == constraint )
+            {
+                hint = entry.hint;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void insert( Qt::SizeHint which, const QSizeF& constraint, const QSizeF& hint )
+    {
+        auto& entry = entries[ next ];
+
+        entry.which = which;
+        entry.constraint = constraint;
+        entry.hint = hint;
+
+        next = ( next + 1 ) % Capacity;
+        count = qMin( count + 1, int( Capacity ) );
+    }
+
+    inline void clear()
+    {
+        count = next = 0;
+    }
+
+  private:
+    enum { Capacity = 4 };
+
+    class Entry
+    {
+      public:
+        Qt::SizeHint which;
+        QSizeF constraint;
+        QSizeF hint;
+    };
+
+    Entry entries[ Capacity ];
+
+    int count = 0;
+    int next = 0;
+};
+
 /*
     Qt 5.12:
         sizeof( QQuickItemPrivate::ExtraData ) -> 184
@@ -143,6 +231,7 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
 
 QskControlPrivate::QskControlPrivate()
     : explicitSizeHints( nullptr )
+    , sizeHintCache( nullptr )
     , sizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred )
     , visiblePlacementPolicy( 0 )
     , hiddenPlacementPolicy( 0 )
@@ -157,10 +246,19 @@ QskControlPrivate::QskControlPrivate()
 QskControlPrivate::~QskControlPrivate()
 {
     delete [] explicitSizeHints;
+    delete sizeHintCache;
+}
+
+void QskControlPrivate::invalidateSizeHints()
+{
+    if ( sizeHintCache )
+        sizeHintCache->clear();
 }
 
 void QskControlPrivate::layoutConstraintChanged()
 {
+    invalidateSizeHints();
+
     if ( !blockLayoutRequestEvents )
     {
         Inherited::layoutConstraintChanged();
@@ -187,6 +285,29 @@ QSizeF QskControlPrivate::implicitSizeHint() const
     return implicitSizeHint( Qt::PreferredSize, QSizeF() );
 }
 
+QSizeF QskControlPrivate::cachedImplicitSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    QSizeF hint;
+
+    if ( sizeHintCache && sizeHintCache->find( which, constraint, hint ) )
+    {
+        qskCountSizeHintLookup( q_func()->metaObject(), true );
+        return hint;
+    }
+
+    qskCountSizeHintLookup( q_func()->metaObject(), false );
+
+    hint = implicitSizeHint( which, constraint );
+
+    if ( sizeHintCache == nullptr )
+        sizeHintCache = new SizeHintCache();
+
+    sizeHintCache->insert( which, constraint, hint );
+
+    return hint;
+}
+
 QSizeF QskControlPrivate::implicitSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
@@ -223,6 +344,8 @@ QSizeF QskControlPrivate::implicitSizeHint(
 
     QSizeF layoutHint;
     {
+        const QskLayoutProfiler::Scope scope( QskLayoutProfiler::LayoutSizeHint, q );
+
         if ( constraint.width() >= 0.0 )
         {
             const QSizeF boundingSize( constraint.width(), 1e6 );
@@ -395,3 +518,52 @@ void QskControlPrivate::setPlacementPolicy(
         this->hiddenPlacementPolicy = policy;
     }
 }
+
+void QskControl::setSizeHintCacheStatisticsEnabled( bool on )
+{
+    qskSizeHintCacheStatisticsEnabled = on;
+}
+
+bool QskControl::isSizeHintCacheStatisticsEnabled()
+{
+    return qskSizeHintCacheStatisticsEnabled;
+}
+
+QHash< QByteArray, QskSizeHintCacheStatistics > QskControl::sizeHintCacheStatistics()
+{
+    QMutexLocker locker( &qskSizeHintCacheStatisticsMutex );
+
+    QHash< QByteArray, QskSizeHintCacheStatistics > statistics;
+
+    for ( auto it = qskSizeHintCacheStatistics.constBegin();
+        it != qskSizeHintCacheStatistics.constEnd(); ++it )
+    {
+        statistics.insert( it.key()->className(), it.value() );
+    }
+
+    return statistics;
+}
+
+void QskControl::resetSizeHintCacheStatistics()
+{
+    QMutexLocker locker( &qskSizeHintCacheStatisticsMutex );
+    qskSizeHintCacheStatistics.clear();
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+QDebug operator<<( QDebug debug, const QskSizeHintCacheStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "SizeHintCache" << '(';
+    debug << "Hits: " << statistics.hits;
+    debug << ", Misses: " << statistics.misses;
+    debug << ", Rate: " << statistics.hitRate();
+    debug << ')';
+
+    return debug;
+}
+
+#endif
@@ -6,6 +6,10 @@
 #include "QskDirtyItemFilter.h"
 #include "QskItem.h"
 
+#include <qhash.h>
+#include <qvector.h>
+#include <qmath.h>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 #include <private/qquickwindow_p.h>
@@ -19,22 +23,65 @@ static inline bool qskIsUpdateBlocked( const QQuickItem* item )
             return qskItem->testUpdateFlag( QskItem::DeferredUpdate );
     }
 
-#if 0
     /*
-        Blocking items, that are outside the window would be easy,
-        but we have not yet found a performant way to send update notifications
-        when an item enters/leaves the window. TODO ...
+        Items outside of the window are handled in cullOffscreenItems()
      */
-    else if ( const auto control = qskControlCast( item ) )
-    {
-        const QRectF itemRect( item->mapToScene( QPointF() ), item->size() );
-        const QRectF sceneRect( 0, 0, item->window()->width(), item->window()->height() );
 
-        return !itemRect.intersects( sceneRect );
+    return false;
+}
+
+static inline bool qskIsCullable( const QQuickItem* item )
+{
+    if ( item->parentItem() == nullptr || !item->isVisible() )
+        return false;
+
+    auto qskItem = qobject_cast< const QskItem* >( item );
+    if ( qskItem == nullptr || !qskItem->testUpdateFlag( QskItem::DeferredOffscreenUpdate ) )
+        return false;
+
+    /*
+        Skipping updates of the transform, opacity or the children
+        would affect the child items, that might be inside of the
+        visible area. So we only defer updates of the content.
+     */
+    const auto d = QQuickItemPrivate::get( item );
+    return ( d->dirtyAttributes & ~QQuickItemPrivate::ContentUpdateMask ) == 0;
+}
+
+// the geometry of an item in the coordinates of its parent
+static inline QRectF qskParentRect( const QQuickItem* item )
+{
+    const auto d = QQuickItemPrivate::get( item );
+
+    const QRectF rect( 0.0, 0.0, d->width, d->height );
+
+    if ( d->scale() == 1.0 && d->rotation() == 0.0 && d->transforms.isEmpty() )
+        return rect.translated( d->x, d->y );
+
+    return item->mapRectToItem( item->parentItem(), rect );
+}
+
+// the area of the window, where the children of item can be seen
+static QRectF qskVisibleChildrenRect( const QQuickItem* item )
+{
+    const auto window = item->window();
+    if ( window == nullptr )
+        return QRectF();
+
+    QRectF rect( 0.0, 0.0, window->width(), window->height() );
+
+    for ( auto it = item; it != nullptr; it = it->parentItem() )
+    {
+        if ( it->clip() )
+        {
+            rect &= it->mapRectToScene( it->clipRect() );
+            if ( rect.isEmpty() )
+                return QRectF();
+        }
     }
-#endif
 
-    return false;
+    // mapping a rotated rectangle results in its bounding rectangle
+    return item->mapRectFromScene( rect );
 }
 
 static inline void qskBlockDirty( QQuickItem* item, bool on )
@@ -67,8 +114,185 @@ namespace
     };
 }
 
+/*
+    Items, whose updates have been deferred because of being outside
+    of the visible area. They are grouped by their parent item and
+    indexed by a grid in the coordinate system of the parent. So finding
+    the items, that have been scrolled into the visible area, is a matter
+    of checking the cells of the visible rectangle only.
+
+    The geometry of an item relative to its parent can't change without
+    the item becoming dirty, what removes it from the index.
+ */
+class QskDirtyItemFilter::OffscreenIndex
+{
+  public:
+    void insert( QQuickItem* item, const QRectF& rect )
+    {
+        remove( item );
+
+        auto& group = m_groups[ item->parentItem() ];
+        group.rects.insert( item, rect );
+
+        const auto cells = cellRange( rect );
+        if ( qint64( cells.width() ) * cells.height() > MaxItemCells )
+        {
+            group.oversized += item;
+        }
+        else
+        {
+            for ( int y = cells.top(); y <= cells.bottom(); y++ )
+            {
+                for ( int x = cells.left(); x <= cells.right(); x++ )
+                    group.cells[ cellKey( x, y ) ] += item;
+            }
+        }
+
+        m_parents.insert( item, item->parentItem() );
+    }
+
+    bool remove( QQuickItem* item )
+    {
+        const auto it = m_parents.find( item );
+        if ( it == m_parents.end() )
+            return false;
+
+        const auto groupIt = m_groups.find( it.value() );
+        m_parents.erase( it );
+
+        if ( groupIt == m_groups.end() )
+            return true;
+
+        auto& group = groupIt.value();
+
+        const auto rect = group.rects.take( item );
+
+        if ( !group.oversized.removeOne( item ) )
+        {
+            const auto cells = cellRange( rect );
+
+            for ( int y = cells.top(); y <= cells.bottom(); y++ )
+            {
+                for ( int x = cells.left(); x <= cells.right(); x++ )
+                {
+                    const auto cellIt = group.cells.find( cellKey( x, y ) );
+                    if ( cellIt != group.cells.end() )
+                    {
+                        cellIt.value().removeOne( item );
+                        if ( cellIt.value().isEmpty() )
+                            group.cells.erase( cellIt );
+                    }
+                }
+            }
+        }
+
+        if ( group.rects.isEmpty() )
+            m_groups.erase( groupIt );
+
+        return true;
+    }
+
+    QVector< QQuickItem* > visibleItems( const QQuickWindow* window ) const
+    {
+        QVector< QQuickItem* > items;
+
+        for ( auto it = m_groups.constBegin(); it != m_groups.constEnd(); ++it )
+        {
+            const auto parentItem = it.key();
+            if ( parentItem->window() != window )
+                continue;
+
+            const auto visibleRect = qskVisibleChildrenRect( parentItem );
+            if ( visibleRect.isEmpty() )
+                continue;
+
+            const auto& group = it.value();
+
+            const auto cells = cellRange( visibleRect );
+            const auto cellCount = qint64( cells.width() ) * cells.height();
+
+            if ( cellCount >= group.rects.size() )
+            {
+                for ( auto rectIt = group.rects.constBegin();
+                    rectIt != group.rects.constEnd(); ++rectIt )
+                {
+                    if ( rectIt.value().intersects( visibleRect ) )
+                        items += rectIt.key();
+                }
+
+                continue;
+            }
+
+            QSet< QQuickItem* > found;
+
+            for ( int y = cells.top(); y <= cells.bottom(); y++ )
+            {
+                for ( int x = cells.left(); x <= cells.right(); x++ )
+                {
+                    const auto cellIt = group.cells.constFind( cellKey( x, y ) );
+                    if ( cellIt == group.cells.constEnd() )
+                        continue;
+
+                    for ( auto item : cellIt.value() )
+                    {
+                        if ( group.rects.value( item ).intersects( visibleRect ) )
+                            found += item;
+                    }
+                }
+            }
+
+            for ( auto item : group.oversized )
+            {
+                if ( group.rects.value( item ).intersects( visibleRect ) )
+                    found += item;
+            }
+
+            for ( auto item : std::as_const( found ) )
+                items += item;
+        }
+
+        return items;
+    }
+
+  private:
+    enum
+    {
+        CellSize = 512,
+        MaxItemCells = 64
+    };
+
+    static inline int cellIndex( qreal value )
+    {
+        const qreal limit = 1 << 24;
+        return qFloor( qBound( -limit, value, limit ) / CellSize );
+    }
+
+    static inline QRect cellRange( const QRectF& rect )
+    {
+        return QRect( QPoint( cellIndex( rect.left() ), cellIndex( rect.top() ) ),
+            QPoint( cellIndex( rect.right() ), cellIndex( rect.bottom() ) ) );
+    }
+
+    static inline quint64 cellKey( int x, int y )
+    {
+        return ( quint64( quint32( x ) ) << 32 ) | quint32( y );
+    }
+
+    class Group
+    {
+      public:
+        QHash< QQuickItem*, QRectF > rects;
+        QHash< quint64, QVector< QQuickItem* > > cells;
+        QVector< QQuickItem* > oversized;
+    };
+
+    QHash< QQuickItem*, Group > m_groups;    // parentItem -> group
+    QHash< QQuickItem*, QQuickItem* > m_parents; // item -> parentItem
+};
+
 QskDirtyItemFilter::QskDirtyItemFilter( QObject* parent )
     : QObject( parent )
+    , m_offscreenIndex( new OffscreenIndex() )
 {
 }
 
@@ -97,15 +321,27 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
         window, [ this, window ] { beforeSynchronizing( window ); },
         Qt::DirectConnection );
 
+    connect( window, &QQuickWindow::afterAnimating,
+        this, [ this, window ] { afterAnimating( window ); } );
+
     connect( window, &QObject::destroyed,
         this, [ this, window ] { m_windows.remove( window ); } );
 }
 
+bool QskDirtyItemFilter::removeItem( QQuickItem* item )
+{
+    return m_offscreenIndex->remove( item );
+}
+
 void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
 {
     filterDirtyList( window, qskIsUpdateBlocked );
 
-    if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
+    if ( QQuickWindowPrivate::get( window )->renderer != nullptr )
+    {
+        cullOffscreenItems( window );
+    }
+    else
     {
         /*
             In this specific initial situation QQuickWindow updates
@@ -120,6 +356,59 @@ void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
     }
 }
 
+void QskDirtyItemFilter::afterAnimating( QQuickWindow* window )
+{
+    /*
+        The items have been polished and we are short before
+        synchronizing: the right moment to find out, what has
+        been moved into the visible area.
+     */
+    const auto items = m_offscreenIndex->visibleItems( window );
+
+    for ( auto item : items )
+    {
+        m_offscreenIndex->remove( item );
+        item->update();
+    }
+}
+
+void QskDirtyItemFilter::cullOffscreenItems( QQuickWindow* window )
+{
+    QHash< const QQuickItem*, QRectF > visibleRects;
+
+    auto d = QQuickWindowPrivate::get( window );
+    for ( auto item = d->dirtyItemList; item != nullptr; )
+    {
+        auto itemPrivate = QQuickItemPrivate::get( item );
+        auto nextItem = itemPrivate->nextDirtyItem;
+
+        if ( qskIsCullable( item ) )
+        {
+            const auto parentItem = item->parentItem();
+
+            auto it = visibleRects.find( parentItem );
+            if ( it == visibleRects.end() )
+                it = visibleRects.insert( parentItem, qskVisibleChildrenRect( parentItem ) );
+
+            const auto rect = qskParentRect( item );
+
+            if ( !rect.isEmpty() && !rect.intersects( it.value() ) )
+            {
+                itemPrivate->removeFromDirtyList();
+                m_offscreenIndex->insert( item, rect );
+
+                item = nextItem;
+                continue;
+            }
+        }
+
+        // the item will be updated now
+        m_offscreenIndex->remove( item );
+
+        item = nextItem;
+    }
+}
+
 void QskDirtyItemFilter::filterDirtyList(
     QQuickWindow* window, bool ( *isBlocked )( const QQuickItem* ) )
 {
@@ -11,6 +11,8 @@
 #include <qobject.h>
 #include <qset.h>
 
+#include <memory>
+
 class QQuickWindow;
 class QQuickItem;
 
@@ -24,13 +26,26 @@ class QskDirtyItemFilter : public QObject
 
     void addWindow( QQuickWindow* window );
 
+    /*
+        Forget about an item, that has been culled because of being
+        outside of the visible area. Returns true, when the item
+        had been culled.
+     */
+    bool removeItem( QQuickItem* );
+
     static void filterDirtyList( QQuickWindow*,
         bool ( *isBlocked )( const QQuickItem* ) );
 
   private:
     void beforeSynchronizing( QQuickWindow* );
+    void afterAnimating( QQuickWindow* );
+
+    void cullOffscreenItems( QQuickWindow* );
+
+    class OffscreenIndex;
 
     QSet< QObject* > m_windows;
+    std::unique_ptr< OffscreenIndex > m_offscreenIndex;
 };
 
 #endif
@@ -287,3 +287,31 @@ QskGestureFilterEvent* QskGestureFilterEvent::clone() const
 {
     return new QskGestureFilterEvent( *this );
 }
+
+// -- QskLayoutRequestEvent
+
+QskLayoutRequestEvent::QskLayoutRequestEvent( const QQuickItem* item )
+    : QEvent( QEvent::LayoutRequest )
+    , m_item( item )
+{
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+
+QskLayoutRequestEvent* QskLayoutRequestEvent::clone() const
+{
+    return new QskLayoutRequestEvent( *this );
+}
+
+#endif
+
+const QQuickItem* qskLayoutRequestItem( const QEvent* event )
+{
+    if ( event && event->type() == QEvent::LayoutRequest )
+    {
+        if ( auto requestEvent = dynamic_cast< const QskLayoutRequestEvent* >( event ) )
+            return requestEvent->item();
+    }
+
+    return nullptr;
+}
@@ -10,6 +10,7 @@
 #include "QskColorFilter.h"
 #include "QskFunctions.h"
 #include "QskGraphic.h"
+#include "QskVectorGraphicNode.h"
 
 #include <QtMath>
 
@@ -21,6 +22,16 @@ QskGraphicLabelSkinlet::QskGraphicLabelSkinlet( QskSkin* skin )
 
 QskGraphicLabelSkinlet::~QskGraphicLabelSkinlet() = default;
 
+void QskGraphicLabelSkinlet::setRenderHint( RenderHint renderHint )
+{
+    m_renderHint = renderHint;
+}
+
+QskGraphicLabelSkinlet::RenderHint QskGraphicLabelSkinlet::renderHint() const
+{
+    return m_renderHint;
+}
+
 QRectF QskGraphicLabelSkinlet::subControlRect( const QskSkinnable* skinnable,
     const QRectF& contentsRect, QskAspect::Subcontrol subControl ) const
 {
@@ -106,6 +117,18 @@ QSGNode* QskGraphicLabelSkinlet::updateGraphicNode(
 {
     using Q = QskGraphicLabel;
 
+    if ( m_renderHint == TessellatedGraphic
+        && QskVectorGraphicNode::isTessellatable( label->graphic() ) )
+    {
+        return updateVectorGraphicNode( label, node );
+    }
+
+    if ( node && node->type() == QSGNode::TransformNodeType )
+    {
+        // the graphic has been tessellated before
+        node = nullptr;
+    }
+
     const auto colorFilter = label->graphicFilter();
     const auto rect = label->subControlRect( Q::Graphic );
 
@@ -127,6 +150,35 @@ QSGNode* QskGraphicLabelSkinlet::updateGraphicNode(
     return node;
 }
 
+QSGNode* QskGraphicLabelSkinlet::updateVectorGraphicNode(
+    const QskGraphicLabel* label, QSGNode* node ) const
+{
+    using Q = QskGraphicLabel;
+
+    const auto& graphic = label->graphic();
+
+    auto rect = QRectF( label->subControlRect( Q::Graphic ) );
+
+    if ( label->fillMode() != Q::Stretch )
+    {
+        const auto size = graphic.defaultSize().scaled(
+            rect.size(), Qt::KeepAspectRatio );
+
+        rect = qskAlignedRectF( rect, size, Qt::AlignCenter );
+    }
+
+    Qt::Orientations mirrored;
+    if ( label->mirror() )
+        mirrored = Qt::Horizontal;
+
+    auto vectorNode = ( node && node->type() == QSGNode::TransformNodeType )
+        ? static_cast< QskVectorGraphicNode* >( node ) : new QskVectorGraphicNode();
+
+    vectorNode->setGraphic( graphic, label->graphicFilter(), rect, mirrored );
+
+    return vectorNode;
+}
+
 QSizeF QskGraphicLabelSkinlet::sizeHint( const QskSkinnable* skinnable,
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
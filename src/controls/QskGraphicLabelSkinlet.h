@@ -25,6 +25,16 @@ class QSK_EXPORT QskGraphicLabelSkinlet : public QskSkinlet
         RoleCount
     };
 
+    enum RenderHint
+    {
+        // rasterizing the graphic into a texture
+        RasterizedGraphic,
+
+        // tessellating the vector data into scene graph geometry
+        TessellatedGraphic
+    };
+    Q_ENUM( RenderHint )
+
     Q_INVOKABLE QskGraphicLabelSkinlet( QskSkin* = nullptr );
     ~QskGraphicLabelSkinlet() override;
 
@@ -34,6 +44,9 @@ class QSK_EXPORT QskGraphicLabelSkinlet : public QskSkinlet
     QSizeF sizeHint( const QskSkinnable*,
         Qt::SizeHint, const QSizeF& ) const override;
 
+    void setRenderHint( RenderHint );
+    RenderHint renderHint() const;
+
   protected:
     QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const override;
@@ -41,6 +54,9 @@ class QSK_EXPORT QskGraphicLabelSkinlet : public QskSkinlet
   private:
     QRect graphicRect( const QskGraphicLabel*, const QRectF& ) const;
     QSGNode* updateGraphicNode( const QskGraphicLabel*, QSGNode* ) const;
+    QSGNode* updateVectorGraphicNode( const QskGraphicLabel*, QSGNode* ) const;
+
+    RenderHint m_renderHint = RasterizedGraphic;
 };
 
 #endif
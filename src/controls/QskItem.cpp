@@ -11,6 +11,7 @@
 #include "QskSkinManager.h"
 #include "QskSkin.h"
 #include "QskDirtyItemFilter.h"
+#include "QskWindow.h"
 
 #include <qglobalstatic.h>
 #include <qquickwindow.h>
@@ -39,6 +40,9 @@ QSK_QT_PRIVATE_END
 
 #include <unordered_set>
 
+extern bool qskDeferPolish( QQuickItem* );
+extern QskPolishStatistics* qskPolishStatistics( QQuickWindow* );
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -52,13 +56,28 @@ static inline void qskApplyUpdateFlags(
     d->applyUpdateFlags( flags );
 }
 
+Q_GLOBAL_STATIC( QskDirtyItemFilter, qskDirtyItemFilter )
+
 static inline void qskFilterWindow( QQuickWindow* window )
 {
     if ( window == nullptr )
         return;
 
-    static QskDirtyItemFilter itemFilter;
-    itemFilter.addWindow( window );
+    qskDirtyItemFilter->addWindow( window );
+}
+
+static inline bool qskHasWindowFilter( int updateFlags )
+{
+    return updateFlags & ( QskItem::DeferredUpdate | QskItem::DeferredOffscreenUpdate );
+}
+
+static inline bool qskRemoveCulledItem( QQuickItem* item )
+{
+    // items, that have been culled for being outside of the window
+    if ( qskDirtyItemFilter.exists() )
+        return qskDirtyItemFilter->removeItem( item );
+
+    return false;
 }
 
 namespace
@@ -235,7 +254,7 @@ QskItem::QskItem( QskItemPrivate& dd, QQuickItem* parent )
     setFlag( QQuickItem::ItemHasContents, true );
     Inherited::setActiveFocusOnTab( false );
 
-    if ( dd.updateFlags & QskItem::DeferredUpdate )
+    if ( qskHasWindowFilter( dd.updateFlags ) )
         qskFilterWindow( window() );
 
     qskRegistry->insert( this );
@@ -257,6 +276,8 @@ QskItem::~QskItem()
 
     if ( qskRegistry )
         qskRegistry->remove( this );
+
+    qskRemoveCulledItem( this );
 }
 
 const char* QskItem::className() const
@@ -706,6 +727,20 @@ void QskItem::applyUpdateFlag( UpdateFlag flag, bool on )
 
             break;
         }
+        case QskItem::DeferredOffscreenUpdate:
+        {
+            if ( on )
+            {
+                qskFilterWindow( window() );
+            }
+            else
+            {
+                if ( qskRemoveCulledItem( this ) )
+                    update();
+            }
+
+            break;
+        }
         case QskItem::DebugForceBackground:
         {
             // no need to mark it dirty
@@ -722,6 +757,8 @@ void QskItem::resetImplicitSize()
 {
     Q_D( QskItem );
 
+    d->invalidateSizeHints();
+
     if ( d->updateFlags & QskItem::DeferredLayout )
     {
         d->blockedImplicitSize = true;
@@ -867,10 +904,12 @@ void QskItem::itemChange( QQuickItem::ItemChange change,
     {
         case QQuickItem::ItemSceneChange:
         {
+            qskRemoveCulledItem( this );
+
             if ( changeData.window )
             {
                 Q_D( const QskItem );
-                if ( d->updateFlags & QskItem::DeferredUpdate )
+                if ( qskHasWindowFilter( d->updateFlags ) )
                     qskFilterWindow( changeData.window );
             }
 
@@ -986,6 +1025,9 @@ void QskItem::itemChange( QQuickItem::ItemChange change,
         }
         case QQuickItem::ItemParentHasChanged:
         {
+            if ( qskRemoveCulledItem( this ) )
+                update();
+
             if( polishOnParentResize() && qskParentListener )
                 qskParentListener->update( parentItem() );
 
@@ -1064,6 +1106,15 @@ void QskItem::updatePolish()
 {
     Q_D( QskItem );
 
+    if ( qskDeferPolish( this ) )
+    {
+        // we will be polished again after our ancestors
+        return;
+    }
+
+    if ( auto statistics = qskPolishStatistics( window() ) )
+        statistics->polishes++;
+
     if ( d->updateFlags & QskItem::DeferredPolish )
     {
         if ( !isVisible() )
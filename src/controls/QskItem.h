@@ -52,8 +52,12 @@ class QSK_EXPORT QskItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        PreferTextureAtlas      =  1 << 5,
+        AsynchronousTextures    =  1 << 6,
 
-        DebugForceBackground    =  1 << 7
+        DebugForceBackground    =  1 << 7,
+
+        DeferredOffscreenUpdate =  1 << 8
     };
 
     Q_ENUM( UpdateFlag )
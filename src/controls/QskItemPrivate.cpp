@@ -6,6 +6,7 @@
 #include "QskItemPrivate.h"
 #include "QskTreeNode.h"
 #include "QskSetup.h"
+#include "QskEvent.h"
 
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
@@ -88,8 +89,13 @@ void QskItemPrivate::applyUpdateFlags( QskItem::UpdateFlags flags )
 
 void QskItemPrivate::layoutConstraintChanged()
 {
-    if ( auto item = q_func()->parentItem() )
-        qskSendEventTo( item, QEvent::LayoutRequest );
+    Q_Q( QskItem );
+
+    if ( auto item = q->parentItem() )
+    {
+        QskLayoutRequestEvent event( q );
+        QCoreApplication::sendEvent( item, &event );
+    }
 }
 
 void QskItemPrivate::implicitSizeChanged()
@@ -97,6 +103,10 @@ void QskItemPrivate::implicitSizeChanged()
     layoutConstraintChanged();
 }
 
+void QskItemPrivate::invalidateSizeHints()
+{
+}
+
 qreal QskItemPrivate::getImplicitWidth() const
 {
     if ( blockedImplicitSize )
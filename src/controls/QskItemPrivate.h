@@ -28,6 +28,7 @@ class QskItemPrivate : public QQuickItemPrivate
   protected:
     virtual void layoutConstraintChanged();
     virtual void implicitSizeChanged();
+    virtual void invalidateSizeHints();
 
   private:
     void cleanupNodes();
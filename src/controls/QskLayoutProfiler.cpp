@@ -0,0 +1,463 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskLayoutProfiler.h"
+#include "QskSkinnable.h"
+
+#include <qatomic.h>
+#include <qdebug.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qmetaobject.h>
+#include <qmutex.h>
+#include <qthread.h>
+
+#include <algorithm>
+
+static QMutex qskProfilerMutex;
+static QAtomicPointer< QskLayoutProfiler > qskActiveProfiler;
+
+static const char* qskOperationNames[] =
+{
+    "updateLayout",
+    "layoutSizeHint",
+    "skinletSizeHint",
+    "updateNode",
+    "hintResolution"
+};
+
+static constexpr int qskOperationCount =
+    sizeof( qskOperationNames ) / sizeof( qskOperationNames[ 0 ] );
+
+static inline quint64 qskCurrentThread()
+{
+    return reinterpret_cast< quintptr >( QThread::currentThreadId() );
+}
+
+static inline void qskAddToStatistics(
+    QskLayoutProfiler::Statistics& statistics, qint64 duration )
+{
+    statistics.count++;
+    statistics.totalTime += duration;
+    statistics.maximumTime = qMax( statistics.maximumTime, duration );
+}
+
+static inline QByteArray qskMicroseconds( qint64 nsecs )
+{
+    return QByteArray::number( nsecs / 1000.0, 'f', 3 );
+}
+
+class QskLayoutProfiler::PrivateData
+{
+  public:
+    PrivateData( bool dumpAtDestruction )
+        : dumpAtDestruction( dumpAtDestruction )
+    {
+    }
+
+    void addRecord( const QskSkinnable* skinnable,
+        Operation operation, qint64 startTime )
+    {
+        const auto duration = timer.nsecsElapsed() - startTime;
+        const auto metaObject = skinnable->metaObject();
+
+        qskAddToStatistics( statistics[ operation ][ metaObject ], duration );
+
+        if ( frame >= frameStatistics.size() )
+            frameStatistics.resize( frame + 1 );
+
+        qskAddToStatistics(
+            frameStatistics[ frame ].statistics[ operation ][ metaObject ], duration );
+
+        if ( records.size() < recordLimit )
+        {
+            const Record record { metaObject, operation, frame,
+                qskCurrentThread(), startTime, duration };
+
+            records += record;
+        }
+    }
+
+    QElapsedTimer timer;
+
+    int operations = ( 1 << qskOperationCount ) - 1;
+    int recordLimit = 1000000;
+
+    int frame = 0;
+    QVector< qint64 > frameTimes;
+
+    QVector< Record > records;
+
+    class FrameStatistics
+    {
+      public:
+        QHash< const QMetaObject*, Statistics > statistics[ qskOperationCount ];
+    };
+
+    /*
+        The statistics are counted independently from the records,
+        that might have been dropped because of the record limit.
+     */
+    QHash< const QMetaObject*, Statistics > statistics[ qskOperationCount ];
+    QVector< FrameStatistics > frameStatistics;
+
+    const bool dumpAtDestruction;
+};
+
+/*
+    Called, when a QskWindow has synchronized its scene graph, what
+    might happen from the scene graph thread.
+ */
+void qskAdvanceLayoutProfilerFrame()
+{
+    if ( qskActiveProfiler.loadAcquire() == nullptr )
+        return;
+
+    QMutexLocker locker( &qskProfilerMutex );
+
+    if ( auto profiler = qskActiveProfiler.loadAcquire() )
+    {
+        auto data = profiler->m_data.get();
+
+        data->frameTimes += data->timer.nsecsElapsed();
+        data->frame++;
+    }
+}
+
+QskLayoutProfiler::Scope::Scope( Operation operation, const QskSkinnable* skinnable )
+    : m_profiler( nullptr )
+    , m_skinnable( skinnable )
+    , m_operation( operation )
+    , m_startTime( 0 )
+{
+    if ( qskActiveProfiler.loadAcquire() == nullptr )
+        return;
+
+    /*
+        The profiler might be deleted from another thread, so we
+        must not access it without holding the lock
+     */
+    QMutexLocker locker( &qskProfilerMutex );
+
+    if ( auto profiler = qskActiveProfiler.loadAcquire() )
+    {
+        const auto data = profiler->m_data.get();
+
+        if ( data->operations & ( 1 << operation ) )
+        {
+            m_profiler = profiler;
+            m_startTime = data->timer.nsecsElapsed();
+        }
+    }
+}
+
+QskLayoutProfiler::Scope::~Scope()
+{
+    if ( m_profiler == nullptr )
+        return;
+
+    QMutexLocker locker( &qskProfilerMutex );
+
+    // the profiler might have been deactivated in the meantime
+    if ( qskActiveProfiler.loadAcquire() == m_profiler )
+        m_profiler->m_data->addRecord( m_skinnable, m_operation, m_startTime );
+}
+
+QskLayoutProfiler::QskLayoutProfiler( bool dumpAtDestruction )
+    : m_data( new PrivateData( dumpAtDestruction ) )
+{
+    setActive( true );
+}
+
+QskLayoutProfiler::~QskLayoutProfiler()
+{
+    setActive( false );
+
+    if ( m_data->dumpAtDestruction )
+        dump();
+}
+
+void QskLayoutProfiler::setActive( bool on )
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    if ( on )
+    {
+        if ( qskActiveProfiler.loadAcquire() == this )
+            return;
+
+        if ( !m_data->timer.isValid() )
+            m_data->timer.start();
+
+        qskActiveProfiler.storeRelease( this );
+    }
+    else
+    {
+        qskActiveProfiler.testAndSetOrdered( this, nullptr );
+    }
+}
+
+bool QskLayoutProfiler::isActive() const
+{
+    return qskActiveProfiler.loadAcquire() == this;
+}
+
+void QskLayoutProfiler::reset()
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    m_data->timer.restart();
+
+    m_data->frame = 0;
+    m_data->frameTimes.clear();
+    m_data->records.clear();
+
+    for ( auto& statistics : m_data->statistics )
+        statistics.clear();
+
+    m_data->frameStatistics.clear();
+}
+
+void QskLayoutProfiler::setOperationEnabled( Operation operation, bool on )
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    if ( on )
+        m_data->operations |= ( 1 << operation );
+    else
+        m_data->operations &= ~( 1 << operation );
+}
+
+bool QskLayoutProfiler::isOperationEnabled( Operation operation ) const
+{
+    return m_data->operations & ( 1 << operation );
+}
+
+void QskLayoutProfiler::setRecordLimit( int limit )
+{
+    QMutexLocker locker( &qskProfilerMutex );
+    m_data->recordLimit = qMax( limit, 0 );
+}
+
+int QskLayoutProfiler::recordLimit() const
+{
+    return m_data->recordLimit;
+}
+
+int QskLayoutProfiler::frameCount() const
+{
+    QMutexLocker locker( &qskProfilerMutex );
+    return m_data->frame;
+}
+
+QVector< QskLayoutProfiler::Record > QskLayoutProfiler::records() const
+{
+    QMutexLocker locker( &qskProfilerMutex );
+    return m_data->records;
+}
+
+QVector< QskLayoutProfiler::Record > QskLayoutProfiler::records( int frame ) const
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    QVector< Record > records;
+
+    for ( const auto& record : std::as_const( m_data->records ) )
+    {
+        if ( record.frame == frame )
+            records += record;
+    }
+
+    return records;
+}
+
+QskLayoutProfiler::Statistics QskLayoutProfiler::statistics(
+    Operation operation, int frame ) const
+{
+    Statistics statistics;
+
+    const auto classStatistics = this->classStatistics( operation, frame );
+    for ( const auto& s : classStatistics )
+    {
+        statistics.count += s.count;
+        statistics.totalTime += s.totalTime;
+        statistics.maximumTime = qMax( statistics.maximumTime, s.maximumTime );
+    }
+
+    return statistics;
+}
+
+QHash< QByteArray, QskLayoutProfiler::Statistics > QskLayoutProfiler::classStatistics(
+    Operation operation, int frame ) const
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    QHash< QByteArray, Statistics > classStatistics;
+
+    const QHash< const QMetaObject*, Statistics >* statistics = nullptr;
+
+    if ( frame < 0 )
+        statistics = &m_data->statistics[ operation ];
+    else if ( frame < m_data->frameStatistics.size() )
+        statistics = &m_data->frameStatistics[ frame ].statistics[ operation ];
+
+    if ( statistics )
+    {
+        for ( auto it = statistics->constBegin(); it != statistics->constEnd(); ++it )
+            classStatistics.insert( it.key()->className(), it.value() );
+    }
+
+    return classStatistics;
+}
+
+QByteArray QskLayoutProfiler::chromeTrace() const
+{
+    QMutexLocker locker( &qskProfilerMutex );
+
+    const auto& records = m_data->records;
+
+    QByteArray trace;
+    trace.reserve( 160 * ( records.size() + m_data->frameTimes.size() ) + 64 );
+
+    trace += "{\"traceEvents\":[";
+
+    bool isFirst = true;
+
+    for ( int i = 0; i < m_data->frameTimes.size(); i++ )
+    {
+        if ( !isFirst )
+            trace += ',';
+
+        trace += "{\"name\":\"Frame ";
+        trace += QByteArray::number( i );
+        trace += "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":";
+        trace += qskMicroseconds( m_data->frameTimes[ i ] );
+        trace += '}';
+
+        isFirst = false;
+    }
+
+    // Chrome expects small numbers as thread ids
+    QHash< quint64, int > threadIds;
+
+    for ( const auto& record : records )
+    {
+        auto it = threadIds.find( record.thread );
+        if ( it == threadIds.end() )
+            it = threadIds.insert( record.thread, threadIds.size() + 1 );
+
+        const auto operationName = qskOperationNames[ record.operation ];
+
+        if ( !isFirst )
+            trace += ',';
+
+        trace += "{\"name\":\"";
+        trace += record.metaObject->className();
+        trace += "::";
+        trace += operationName;
+        trace += "\",\"cat\":\"";
+        trace += operationName;
+        trace += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        trace += QByteArray::number( it.value() );
+        trace += ",\"ts\":";
+        trace += qskMicroseconds( record.startTime );
+        trace += ",\"dur\":";
+        trace += qskMicroseconds( record.duration );
+        trace += ",\"args\":{\"frame\":";
+        trace += QByteArray::number( record.frame );
+        trace += "}}";
+
+        isFirst = false;
+    }
+
+    trace += "],\"displayTimeUnit\":\"ms\"}";
+
+    return trace;
+}
+
+bool QskLayoutProfiler::writeChromeTrace( const QString& fileName ) const
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        qWarning() << "QskLayoutProfiler: can't write" << fileName;
+        return false;
+    }
+
+    return file.write( chromeTrace() ) >= 0;
+}
+
+void QskLayoutProfiler::debugStatistics( QDebug debug, Operation operation ) const
+{
+    const auto classStatistics = this->classStatistics( operation );
+
+    using Entry = QPair< QByteArray, Statistics >;
+
+    QVector< Entry > entries;
+    entries.reserve( classStatistics.size() );
+
+    for ( auto it = classStatistics.constBegin(); it != classStatistics.constEnd(); ++it )
+        entries += qMakePair( it.key(), it.value() );
+
+    std::sort( entries.begin(), entries.end(),
+        []( const Entry& e1, const Entry& e2 )
+        { return e1.second.totalTime > e2.second.totalTime; } );
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    for ( const auto& entry : std::as_const( entries ) )
+    {
+        const auto& s = entry.second;
+
+        debug << "\n    " << entry.first.constData() << ": "
+              << "count: " << s.count
+              << ", total: " << s.totalTime / 1e6 << "ms"
+              << ", maximum: " << s.maximumTime / 1e6 << "ms";
+    }
+}
+
+void QskLayoutProfiler::dump() const
+{
+    QDebug debug = qDebug();
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "* Layout Profiler, frames: " << frameCount();
+
+    for ( int i = 0; i < qskOperationCount; i++ )
+    {
+        const auto operation = static_cast< Operation >( i );
+
+        debug << "\n  " << qskOperationNames[ i ] << ": ";
+        debugStatistics( debug, operation );
+    }
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+QDebug operator<<( QDebug debug, const QskLayoutProfiler& profiler )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "QskLayoutProfiler( frames: " << profiler.frameCount();
+
+    for ( int i = 0; i < qskOperationCount; i++ )
+    {
+        const auto s = profiler.statistics(
+            static_cast< QskLayoutProfiler::Operation >( i ) );
+
+        debug << ", " << qskOperationNames[ i ] << ": "
+              << s.count << '/' << s.totalTime / 1e6 << "ms";
+    }
+
+    debug << " )";
+
+    return debug;
+}
+
+#endif
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_LAYOUT_PROFILER_H
+#define QSK_LAYOUT_PROFILER_H
+
+#include "QskGlobal.h"
+
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qvector.h>
+
+#include <memory>
+
+class QskSkinnable;
+class QMetaObject;
+class QString;
+
+/*
+    QskLayoutProfiler records the number and duration of the layout
+    related operations of the controls: updateLayout, layoutSizeHint,
+    QskSkinlet::sizeHint, updateNode and the resolution of skin hints.
+
+    Only one profiler can be active at a time. As long as no profiler is
+    active the instrumented code paths only check a pointer, so there
+    is no need to remove the instrumentation in release builds.
+
+    A frame ends, when the scene graph of a QskWindow has been synchronized.
+    With more than one window each synchronization counts as a frame.
+
+    The recorded operations can be inspected in-process or written in the
+    Chrome trace event format, that can be loaded into chrome://tracing
+    or https://ui.perfetto.dev.
+ */
+class QSK_EXPORT QskLayoutProfiler
+{
+  public:
+    enum Operation
+    {
+        UpdateLayout,
+        LayoutSizeHint,
+        SkinletSizeHint,
+        UpdateNode,
+        HintResolution
+    };
+
+    class Record
+    {
+      public:
+        const QMetaObject* metaObject;
+        Operation operation;
+        int frame;
+        quint64 thread;
+
+        // nanoseconds since the profiler has been activated
+        qint64 startTime;
+        qint64 duration;
+    };
+
+    class Statistics
+    {
+      public:
+        int count = 0;
+
+        // nanoseconds
+        qint64 totalTime = 0;
+        qint64 maximumTime = 0;
+    };
+
+    class QSK_EXPORT Scope
+    {
+      public:
+        Scope( Operation, const QskSkinnable* );
+        ~Scope();
+
+      private:
+        Q_DISABLE_COPY( Scope )
+
+        QskLayoutProfiler* m_profiler;
+        const QskSkinnable* m_skinnable;
+        Operation m_operation;
+        qint64 m_startTime;
+    };
+
+    QskLayoutProfiler( bool dumpAtDestruction = false );
+    ~QskLayoutProfiler();
+
+    void setActive( bool );
+    bool isActive() const;
+
+    void reset();
+
+    /*
+        Hint resolution happens very often and is usually cheap, so
+        disabling it reduces the overhead of the profiler.
+        All operations are enabled by default.
+     */
+    void setOperationEnabled( Operation, bool );
+    bool isOperationEnabled( Operation ) const;
+
+    /*
+        The statistics - also those of each frame - are always updated,
+        but the individual records are dropped, when exceeding the limit.
+        The default is 1000000.
+     */
+    void setRecordLimit( int );
+    int recordLimit() const;
+
+    int frameCount() const;
+
+    QVector< Record > records() const;
+    QVector< Record > records( int frame ) const;
+
+    // a frame of -1 means all frames
+    Statistics statistics( Operation, int frame = -1 ) const;
+    QHash< QByteArray, Statistics > classStatistics( Operation, int frame = -1 ) const;
+
+    QByteArray chromeTrace() const;
+    bool writeChromeTrace( const QString& fileName ) const;
+
+    void debugStatistics( QDebug, Operation ) const;
+    void dump() const;
+
+  private:
+    Q_DISABLE_COPY( QskLayoutProfiler )
+
+    friend void qskAdvanceLayoutProfilerFrame();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskLayoutProfiler& );
+
+#endif
+
+#endif
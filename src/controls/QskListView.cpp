@@ -11,6 +11,7 @@
 
 #include <qguiapplication.h>
 #include <qstylehints.h>
+#include <qvector.h>
 
 #include <qmath.h>
 
@@ -28,24 +29,162 @@ static inline int qskRowAt( const QskListView* listView, const QPointF& pos )
     if ( rect.contains( pos ) )
     {
         const auto y = pos.y() - rect.top() + listView->scrollPos().y();
-
-        const int row = y / listView->rowHeight();
-        if ( row >= 0 && row < listView->rowCount() )
-            return row;
+        return listView->rowAt( y );
     }
 
     return -1;
 }
 
+namespace
+{
+    // rows, that have been modified in a specific revision
+    class RowChange
+    {
+      public:
+        int first;
+        int last;
+        quint64 revision;
+    };
+
+    /*
+        A Fenwick tree ( binary indexed tree ) of the row heights, so that
+        finding the position of a row or the row at a position are O(log n),
+        even for lists with a huge number of rows.
+     */
+    class RowIndex
+    {
+      public:
+        void reset( const QskListView* listView )
+        {
+            const int count = qMax( listView->rowCount(), 0 );
+
+            m_heights.resize( count );
+            m_tree.fill( 0.0, count + 1 );
+
+            for ( int row = 0; row < count; row++ )
+                m_heights[ row ] = listView->rowHeightAt( row );
+
+            // building the tree in O(n)
+
+            for ( int i = 1; i <= count; i++ )
+            {
+                m_tree[ i ] += m_heights[ i - 1 ];
+
+                const int j = i + ( i & -i );
+                if ( j <= count )
+                    m_tree[ j ] += m_tree[ i ];
+            }
+
+            m_mask = 1;
+            while ( ( m_mask << 1 ) <= count )
+                m_mask <<= 1;
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_tree.clear();
+            m_mask = 1;
+        }
+
+        inline int count() const { return m_heights.count(); }
+
+        void setHeight( int row, qreal height )
+        {
+            const auto delta = height - m_heights[ row ];
+            if ( delta == 0.0 )
+                return;
+
+            m_heights[ row ] = height;
+
+            for ( int i = row + 1; i <= count(); i += ( i & -i ) )
+                m_tree[ i ] += delta;
+        }
+
+        // the accumulated heights of all rows above
+        qreal position( int row ) const
+        {
+            qreal pos = 0.0;
+
+            for ( int i = qMin( row, count() ); i > 0; i -= ( i & -i ) )
+                pos += m_tree[ i ];
+
+            return pos;
+        }
+
+        // the number of rows, that end above pos
+        int rowAt( qreal pos ) const
+        {
+            int row = 0;
+
+            for ( int step = m_mask; step > 0; step >>= 1 )
+            {
+                const int i = row + step;
+                if ( i <= count() && m_tree[ i ] <= pos )
+                {
+                    row = i;
+                    pos -= m_tree[ i ];
+                }
+            }
+
+            return row;
+        }
+
+      private:
+        QVector< qreal > m_heights;
+        QVector< qreal > m_tree;
+
+        int m_mask = 1;
+    };
+}
+
 class QskListView::PrivateData
 {
   public:
     PrivateData()
         : preferredWidthFromColumns( false )
+        , variableRowHeights( false )
+        , rowTracking( false )
         , selectionMode( QskListView::SingleSelection )
     {
     }
 
+    void addRowChange( int first, int last )
+    {
+        if ( !rowTracking || first > last )
+            return;
+
+        rowRevision++;
+
+        if ( rowChanges.size() >= MaxRowChanges )
+        {
+            // too many changes: considering all rows as modified
+            resetRevision = rowRevision;
+            rowChanges.clear();
+        }
+        else
+        {
+            rowChanges += RowChange { first, last, rowRevision };
+        }
+    }
+
+    void resetRowChanges()
+    {
+        resetRevision = ++rowRevision;
+        rowChanges.clear();
+    }
+
+    const RowIndex& rowIndex( const QskListView* listView )
+    {
+        if ( isRowIndexDirty || ( index.count() != listView->rowCount() ) )
+        {
+            index.reset( listView );
+            isRowIndexDirty = false;
+        }
+
+        return index;
+    }
+
     void setRowState( QskListView* listView, int row, QskAspect::State state )
     {
         using Q = QskListView;
@@ -68,6 +207,12 @@ class QskListView::PrivateData
             startTransitions( listView, row, states, states | state );
         }
 
+        if ( storedRow >= 0 )
+            addRowChange( storedRow, storedRow );
+
+        if ( row >= 0 )
+            addRowChange( row, row );
+
         storedRow = row;
         listView->update();
     }
@@ -90,8 +235,20 @@ class QskListView::PrivateData
      */
 
     bool preferredWidthFromColumns : 1;
+    bool variableRowHeights : 1;
+    bool rowTracking : 1;
+    bool isRowIndexDirty = true;
+
     SelectionMode selectionMode : 4;
 
+    RowIndex index;
+
+    enum { MaxRowChanges = 64 };
+
+    quint64 rowRevision = 0;
+    quint64 resetRevision = 0;
+    QVector< RowChange > rowChanges;
+
     int hoveredRow = -1;
     int pressedRow = -1;
     int selectedRow = -1;
@@ -126,11 +283,138 @@ bool QskListView::preferredWidthFromColumns() const
     return m_data->preferredWidthFromColumns;
 }
 
+void QskListView::setVariableRowHeights( bool on )
+{
+    if ( on != m_data->variableRowHeights )
+    {
+        m_data->variableRowHeights = on;
+
+        m_data->index.clear();
+        m_data->isRowIndexDirty = true;
+
+        updateScrollableSize();
+        updateAllRows();
+
+        Q_EMIT variableRowHeightsChanged();
+    }
+}
+
+bool QskListView::hasVariableRowHeights() const
+{
+    return m_data->variableRowHeights;
+}
+
+qreal QskListView::rowHeightAt( int ) const
+{
+    return rowHeight();
+}
+
+qreal QskListView::rowPosition( int row ) const
+{
+    row = qBound( 0, row, rowCount() );
+
+    if ( m_data->variableRowHeights )
+        return m_data->rowIndex( this ).position( row );
+
+    return row * rowHeight();
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    if ( y < 0.0 )
+        return -1;
+
+    int row;
+
+    if ( m_data->variableRowHeights )
+    {
+        row = m_data->rowIndex( this ).rowAt( y );
+    }
+    else
+    {
+        const auto h = rowHeight();
+        row = ( h > 0.0 ) ? qFloor( y / h ) : -1;
+    }
+
+    return ( row >= 0 && row < rowCount() ) ? row : -1;
+}
+
+void QskListView::updateRowHeight( int row )
+{
+    if ( !m_data->variableRowHeights )
+        return;
+
+    if ( m_data->isRowIndexDirty || row < 0 || row >= m_data->index.count() )
+    {
+        updateScrollableSize();
+        return;
+    }
+
+    m_data->index.setHeight( row, rowHeightAt( row ) );
+
+    const auto h = m_data->index.position( m_data->index.count() );
+    setScrollableSize( QSizeF( scrollableSize().width(), h ) );
+
+    updateRows( row, row );
+}
+
+void QskListView::setRowTracking( bool on )
+{
+    if ( on != m_data->rowTracking )
+    {
+        m_data->rowTracking = on;
+        updateAllRows();
+    }
+}
+
+bool QskListView::hasRowTracking() const
+{
+    return m_data->rowTracking;
+}
+
+void QskListView::updateRows( int first, int last )
+{
+    m_data->addRowChange( first, last );
+    update();
+}
+
+void QskListView::updateAllRows()
+{
+    m_data->resetRowChanges();
+    update();
+}
+
+quint64 QskListView::rowRevision() const
+{
+    return m_data->rowRevision;
+}
+
+bool QskListView::isRowModified( int row, quint64 revision ) const
+{
+    // modified after revision
+
+    if ( !m_data->rowTracking || revision < m_data->resetRevision )
+        return true;
+
+    for ( const auto& change : m_data->rowChanges )
+    {
+        if ( change.revision > revision
+            && row >= change.first && row <= change.last )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void QskListView::setTextOptions( const QskTextOptions& textOptions )
 {
     if ( setTextOptionsHint( Text, textOptions ) )
     {
         updateScrollableSize();
+        updateAllRows();
+
         Q_EMIT textOptionsChanged();
     }
 }
@@ -145,6 +429,8 @@ void QskListView::resetTextOptions()
     if ( resetTextOptionsHint( Text ) )
     {
         updateScrollableSize();
+        updateAllRows();
+
         Q_EMIT textOptionsChanged();
     }
 }
@@ -281,7 +567,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowPosition( row );
+        const qreal rowHeight = rowHeightAt( row );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -291,9 +579,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -371,8 +659,22 @@ void QskListView::hoverLeaveEvent( QHoverEvent* event )
 
 void QskListView::changeEvent( QEvent* event )
 {
-    if ( event->type() == QEvent::StyleChange )
-        updateScrollableSize();
+    switch( static_cast< int >( event->type() ) )
+    {
+        case QEvent::StyleChange:
+        {
+            updateScrollableSize();
+            m_data->resetRowChanges();
+
+            break;
+        }
+        case QEvent::LocaleChange:
+        case QEvent::FontChange:
+        {
+            m_data->resetRowChanges();
+            break;
+        }
+    }
 
     Inherited::changeEvent( event );
 }
@@ -398,19 +700,47 @@ QskAspect::States QskListView::rowStates( int row ) const
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
+    if ( !listView->hasVariableRowHeights() )
+    {
+        const auto rowHeight = listView->rowHeight();
+
+        if ( dy > 0 )
+        {
+            y = qFloor( y / rowHeight ) * rowHeight;
+        }
+        else
+        {
+            y += viewHeight;
+            y = qCeil( y / rowHeight ) * rowHeight;
+            y -= viewHeight;
+        }
+
+        return y;
+    }
+
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+            y = listView->rowPosition( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+        {
+            const auto rowPos = listView->rowPosition( row );
+            if ( rowPos < y )
+                y = rowPos + listView->rowHeightAt( row );
+        }
+
         y -= viewHeight;
     }
 
@@ -457,7 +787,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -471,7 +801,9 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    m_data->isRowIndexDirty = true;
+
+    const double h = rowPosition( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
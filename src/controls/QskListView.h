@@ -26,6 +26,9 @@ class QSK_EXPORT QskListView : public QskScrollView
     Q_PROPERTY( bool preferredWidthFromColumns READ preferredWidthFromColumns
         WRITE setPreferredWidthFromColumns NOTIFY preferredWidthFromColumnsChanged() )
 
+    Q_PROPERTY( bool variableRowHeights READ hasVariableRowHeights
+        WRITE setVariableRowHeights NOTIFY variableRowHeightsChanged() )
+
     using Inherited = QskScrollView;
 
   public:
@@ -49,6 +52,16 @@ class QSK_EXPORT QskListView : public QskScrollView
     void setSelectionMode( SelectionMode );
     SelectionMode selectionMode() const;
 
+    /*
+        By default all rows have the height of rowHeight(). Lists with
+        rows of different heights have to enable variableRowHeights and
+        to implement rowHeightAt(). The positions of the rows are stored
+        in an index, that needs to be updated, when heights are changing:
+        see updateRowHeight(), updateScrollableSize().
+     */
+    void setVariableRowHeights( bool );
+    bool hasVariableRowHeights() const;
+
     void setTextOptions( const QskTextOptions& textOptions );
     void resetTextOptions();
     QskTextOptions textOptions() const;
@@ -62,6 +75,22 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    virtual qreal rowHeightAt( int row ) const;
+
+    qreal rowPosition( int row ) const;
+    int rowAt( qreal y ) const;
+
+    /*
+        By default the nodes of all visible rows are updated, whenever
+        the list view is updated. Lists with row tracking report their
+        modifications with updateRows(), so that the skinlet
+        can restrict the updates to the nodes of the modified rows.
+     */
+    bool hasRowTracking() const;
+
+    quint64 rowRevision() const;
+    bool isRowModified( int row, quint64 revision ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
     QRectF focusIndicatorRect() const override;
@@ -74,6 +103,7 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void selectionModeChanged();
     void preferredWidthFromColumnsChanged();
+    void variableRowHeightsChanged();
     void textOptionsChanged();
 
   protected:
@@ -95,6 +125,12 @@ class QSK_EXPORT QskListView : public QskScrollView
 #endif
 
     void updateScrollableSize();
+    void updateRowHeight( int row );
+
+    void setRowTracking( bool );
+
+    void updateRows( int first, int last );
+    void updateAllRows();
 
     void componentComplete() override;
 
@@ -10,29 +10,132 @@
 #include "QskGraphic.h"
 #include "QskBoxHints.h"
 #include "QskSGNode.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
 #include "QskSkinStateChanger.h"
+#include "QskSkinTransition.h"
 #include "QskQuick.h"
 
 #include <qmath.h>
+#include <qquickwindow.h>
 #include <qsgnode.h>
 #include <qtransform.h>
+#include <qvector.h>
+
+static inline bool qskIsRowAnimated( const QskListView* listView, int row )
+{
+    using A = QskAspect;
+    using Q = QskListView;
+
+    return listView->runningHintAnimator( Q::Text | A::Color, row )
+        || listView->runningHintAnimator( Q::Text | A::TextColor, row )
+        || listView->runningHintAnimator( Q::Graphic | A::GraphicRole, row );
+}
 
 namespace
 {
+    // everything, that affects the nodes of all rows
+    class StyleKey
+    {
+      public:
+        StyleKey() = default;
+
+        StyleKey( const QskListView* listView )
+            : skin( listView->effectiveSkin() )
+            , skinGeneration( skin ? skin->hintTable().generation() : 0 )
+            , localGeneration( listView->hintTable().generation() )
+            , states( listView->skinStates() )
+            , devicePixelRatio( listView->window()
+                ? listView->window()->effectiveDevicePixelRatio() : 1.0 )
+        {
+        }
+
+        inline bool operator==( const StyleKey& other ) const
+        {
+            return ( skin == other.skin )
+                && ( skinGeneration == other.skinGeneration )
+                && ( localGeneration == other.localGeneration )
+                && ( states == other.states )
+                && ( devicePixelRatio == other.devicePixelRatio );
+        }
+
+        inline bool operator!=( const StyleKey& other ) const
+        {
+            return !( *this == other );
+        }
+
+      private:
+        const QskSkin* skin = nullptr;
+        quint64 skinGeneration = 0;
+        quint64 localGeneration = 0;
+        QskAspect::States states;
+        qreal devicePixelRatio = 0.0;
+    };
+
     class ForegroundNode : public QSGNode
     {
       public:
+        ~ForegroundNode() override
+        {
+            qDeleteAll( m_pool );
+        }
+
         void invalidate()
         {
             removeAllChildNodes();
             m_columnCount = m_oldRowMin = m_oldRowMax = -1;
+
+            m_validRowMin = 0;
+            m_validRowMax = -1;
+
+            qDeleteAll( m_pool );
+            m_pool.clear();
         }
 
-        void rearrangeNodes( int rowMin, int rowMax, int columnCount )
+        /*
+            With rows of different heights the number of visible rows
+            changes, when scrolling. Instead of deleting the cell nodes,
+            that are not needed anymore, we keep them for rows,
+            that are scrolling in later.
+         */
+        void recycleNodesFrom( QSGNode* node )
         {
+            while ( node )
+            {
+                auto nextNode = node->nextSibling();
+
+                removeChildNode( node );
+
+                if ( m_pool.size() < MaxPoolSize )
+                    m_pool += node;
+                else
+                    delete node;
+
+                node = nextNode;
+            }
+        }
+
+        QSGNode* takeRecycledNode()
+        {
+            if ( m_pool.isEmpty() )
+                return nullptr;
+
+            auto node = m_pool.takeLast();
+            appendChildNode( node );
+
+            return node;
+        }
+
+        void rearrangeNodes( const QskListView* listView, int rowMin, int rowMax )
+        {
+            const auto columnCount = listView->columnCount();
+
             const bool doReorder = ( columnCount == m_columnCount )
                 && ( rowMin <= m_oldRowMax ) && ( rowMax >= m_oldRowMin );
 
+            m_validRowMin = 0;
+            m_validRowMax = -1;
+
             if ( doReorder )
             {
                 /*
@@ -60,6 +163,9 @@ namespace
                             appendChildNode( childNode );
                         }
                     }
+
+                    m_validRowMin = rowMin;
+                    m_validRowMax = qMin( rowMax, m_oldRowMax );
                 }
                 else
                 {
@@ -72,14 +178,65 @@ namespace
                             prependChildNode( childNode );
                         }
                     }
+
+                    // the trailing rows have been moved to the front
+                    m_validRowMin = m_oldRowMin;
+                    m_validRowMax = qMin( rowMax, m_oldRowMax - ( m_oldRowMin - rowMin ) );
                 }
             }
 
+            /*
+                Nodes of rows, that are at the same position as before,
+                can be kept, when the row has not been modified. Changes,
+                that affect all rows, are detected here.
+             */
+
+            QVector< qreal > columnWidths;
+            columnWidths.reserve( columnCount );
+
+            for ( int col = 0; col < columnCount; col++ )
+                columnWidths += listView->columnWidth( col );
+
+            const StyleKey styleKey( listView );
+
+            if ( QskSkinTransition::isRunning()
+                || ( styleKey != m_styleKey ) || ( columnWidths != m_columnWidths ) )
+            {
+                m_validRowMin = 0;
+                m_validRowMax = -1;
+            }
+
+            m_styleKey = styleKey;
+            m_columnWidths = columnWidths;
+
             m_oldRowMin = rowMin;
             m_oldRowMax = rowMax;
             m_columnCount = columnCount;
         }
 
+        bool isRowValid( const QskListView* listView, int row ) const
+        {
+            if ( row < m_validRowMin || row > m_validRowMax )
+                return false;
+
+            if ( m_rowHeights[ row - m_rowHeightsMin ] != listView->rowHeightAt( row ) )
+                return false;
+
+            return !listView->isRowModified( row, m_rowRevision )
+                && !qskIsRowAnimated( listView, row );
+        }
+
+        void setRowsUpdated( const QskListView* listView, int rowMin, int rowMax )
+        {
+            m_rowHeights.resize( qMax( rowMax - rowMin + 1, 0 ) );
+
+            for ( int row = rowMin; row <= rowMax; row++ )
+                m_rowHeights[ row - rowMin ] = listView->rowHeightAt( row );
+
+            m_rowHeightsMin = rowMin;
+            m_rowRevision = listView->rowRevision();
+        }
+
       private:
         /*
             When scrolling the majority of the child nodes are simply translated
@@ -90,6 +247,22 @@ namespace
         int m_oldRowMin = -1;
         int m_oldRowMax = -1;
         int m_columnCount = -1;
+
+        // rows, where the nodes are from the previous update
+        int m_validRowMin = 0;
+        int m_validRowMax = -1;
+
+        // the state of the previous update
+        StyleKey m_styleKey;
+        QVector< qreal > m_columnWidths;
+
+        int m_rowHeightsMin = 0;
+        QVector< qreal > m_rowHeights;
+
+        quint64 m_rowRevision = 0;
+
+        enum { MaxPoolSize = 256 };
+        QVector< QSGNode* > m_pool;
     };
 
     class ListViewNode final : public QSGTransformNode
@@ -110,15 +283,19 @@ namespace
             setMatrix( QTransform::fromTranslate( -scrollPos.x(), -scrollPos.y() ) );
 
             m_clipRect = listView->viewContentsRect();
-            m_rowHeight = listView->rowHeight();
 
-            m_rowMin = qFloor( scrollPos.y() / m_rowHeight );
+            const auto rowCount = listView->rowCount();
+
+            const auto y1 = scrollPos.y();
+            const auto y2 = y1 + m_clipRect.height() - 10e-6;
 
-            const auto rowMax = ( scrollPos.y() + m_clipRect.height() ) / m_rowHeight;
-            m_rowMax = qFloor( rowMax - 10e-6 );
+            m_rowMin = listView->rowAt( y1 );
+            if ( m_rowMin < 0 )
+                m_rowMin = ( y1 < 0.0 ) ? 0 : rowCount;
 
-            if ( m_rowMax >= listView->rowCount() )
-                m_rowMax = listView->rowCount() - 1;
+            m_rowMax = listView->rowAt( y2 );
+            if ( m_rowMax < 0 )
+                m_rowMax = ( y2 < 0.0 ) ? -1 : rowCount - 1;
         }
 
         QRectF clipRect() const { return m_clipRect; }
@@ -127,8 +304,6 @@ namespace
         int rowMax() const { return m_rowMax; }
         int rowCount() const { return m_rowMax - m_rowMin + 1; }
 
-        int rowHeight() const { return m_rowHeight; }
-
         QSGNode* backgroundNode() { return &m_backgroundNode; }
         ForegroundNode* foregroundNode() { return &m_foregroundNode; }
 
@@ -136,7 +311,6 @@ namespace
         // caching some calculations to speed things up
 
         QRectF m_clipRect;
-        qreal m_rowHeight;
 
         int m_rowMin, m_rowMax;
 
@@ -239,7 +413,7 @@ void QskListViewSkinlet::updateForegroundNodes(
     const int rowMin = listViewNode->rowMin();
     const int rowMax = listViewNode->rowMax();
 
-    foregroundNode->rearrangeNodes( rowMin, rowMax, listView->columnCount() );
+    foregroundNode->rearrangeNodes( listView, rowMin, rowMax );
 
 #if 1
     // should be optimized for visible columns only
@@ -252,11 +426,12 @@ void QskListViewSkinlet::updateForegroundNodes(
     updateVisibleForegroundNodes(
         listView, foregroundNode, rowMin, rowMax, margins );
 
+    foregroundNode->setRowsUpdated( listView, rowMin, rowMax );
+
     // finally putting the nodes into their position
     auto node = foregroundNode->firstChild();
 
-    const auto rowHeight = listView->rowHeight();
-    auto y = clipRect.top() + rowMin * rowHeight;
+    auto y = clipRect.top() + listView->rowPosition( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
@@ -274,7 +449,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += listView->rowHeightAt( row );
     }
 }
 
@@ -282,16 +457,30 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     const QskListView* listView, QSGNode* parentNode,
     int rowMin, int rowMax, const QMarginsF& margins ) const
 {
+    auto foregroundNode = static_cast< ForegroundNode* >( parentNode );
+
     auto node = parentNode->firstChild();
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        const auto h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+        if ( foregroundNode->isRowValid( listView, row ) )
+        {
+            // unmodified row, where the nodes are already in place
+            for ( int col = 0; col < listView->columnCount(); col++ )
+                node = node->nextSibling();
+
+            continue;
+        }
+
+        const auto h = listView->rowHeightAt( row ) - ( margins.top() + margins.bottom() );
 
         for ( int col = 0; col < listView->columnCount(); col++ )
         {
             const auto w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
+            if ( node == nullptr )
+                node = foregroundNode->takeRecycledNode();
+
             node = updateForegroundNode( listView,
                 parentNode, static_cast< QSGTransformNode* >( node ),
                 row, col, QSizeF( w, h ) );
@@ -300,7 +489,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
         }
     }
 
-    QskSGNode::removeAllChildNodesFrom( parentNode, node );
+    foregroundNode->recycleNodesFrom( node );
 }
 
 QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
@@ -485,9 +674,9 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
         const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
 
         const auto w = clipRect.width();
-        const auto h = listView->rowHeight();
+        const auto h = listView->rowHeightAt( index );
         const auto x = clipRect.left() + listView->scrollPos().x();
-        const auto y = clipRect.top() + index * h;
+        const auto y = clipRect.top() + listView->rowPosition( index );
 
         return QRectF( x, y, w, h );
     }
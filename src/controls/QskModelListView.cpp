@@ -0,0 +1,387 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskModelListView.h"
+#include "QskFunctions.h"
+
+#include <qabstractitemmodel.h>
+#include <qfontmetrics.h>
+#include <qpointer.h>
+#include <qvector.h>
+
+#include <limits>
+
+namespace
+{
+    class RowRange
+    {
+      public:
+        int first;
+        int last;
+    };
+}
+
+class QskModelListView::PrivateData
+{
+  public:
+    void resetPending()
+    {
+        isModelDirty = false;
+        isSizeDirty = false;
+
+        measuredRanges.clear();
+
+        affectedFirst = std::numeric_limits< int >::max();
+        affectedLast = -1;
+    }
+
+    void addAffectedRows( int first, int last )
+    {
+        affectedFirst = qMin( affectedFirst, first );
+        affectedLast = qMax( affectedLast, last );
+    }
+
+    void addMeasuredRows( int first, int last )
+    {
+        if ( isModelDirty )
+            return; // all rows will be measured
+
+        if ( measuredRanges.size() >= MaxRangeCount )
+        {
+            // too fragmented, measuring all rows
+            isModelDirty = true;
+            return;
+        }
+
+        measuredRanges += RowRange { first, last };
+    }
+
+    QPointer< QAbstractItemModel > model;
+
+    QVector< qreal > columnWidthHints;
+    QVector< qreal > textWidths;
+
+    /*
+        Changes of the model are collected and processed
+        in the next polish cycle, what usually happens once per frame.
+     */
+    bool isModelDirty = true;
+    bool isSizeDirty = false;
+
+    enum { MaxRangeCount = 64 };
+    QVector< RowRange > measuredRanges;
+
+    int affectedFirst = std::numeric_limits< int >::max();
+    int affectedLast = -1;
+};
+
+QskModelListView::QskModelListView( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+    setRowTracking( true );
+}
+
+QskModelListView::~QskModelListView()
+{
+}
+
+void QskModelListView::setModel( QAbstractItemModel* model )
+{
+    if ( model == m_data->model )
+        return;
+
+    if ( m_data->model )
+        m_data->model->disconnect( this );
+
+    m_data->model = model;
+
+    if ( model )
+    {
+        using M = QAbstractItemModel;
+
+        connect( model, &M::rowsInserted, this,
+            [ this ]( const QModelIndex& parent, int first, int last )
+            {
+                if ( !parent.isValid() )
+                    insertModelRows( first, last );
+            } );
+
+        connect( model, &M::rowsRemoved, this,
+            [ this ]( const QModelIndex& parent, int first, int last )
+            {
+                if ( !parent.isValid() )
+                    removeModelRows( first, last );
+            } );
+
+        connect( model, &M::dataChanged, this,
+            [ this ]( const QModelIndex& topLeft, const QModelIndex& bottomRight )
+            {
+                if ( !topLeft.parent().isValid() )
+                    changeModelRows( topLeft.row(), bottomRight.row() );
+            } );
+
+        // changes, that are not worth to be handled incrementally
+
+        connect( model, &M::modelReset, this, &QskModelListView::resetModelRows );
+        connect( model, &M::layoutChanged, this, &QskModelListView::resetModelRows );
+        connect( model, &M::rowsMoved, this, &QskModelListView::resetModelRows );
+        connect( model, &M::columnsInserted, this, &QskModelListView::resetModelRows );
+        connect( model, &M::columnsRemoved, this, &QskModelListView::resetModelRows );
+        connect( model, &M::columnsMoved, this, &QskModelListView::resetModelRows );
+        connect( model, &QObject::destroyed, this, &QskModelListView::resetModelRows );
+    }
+
+    resetModelRows();
+
+    if ( selectedRow() >= rowCount() )
+        setSelectedRow( -1 );
+
+    Q_EMIT modelChanged();
+}
+
+QAbstractItemModel* QskModelListView::model() const
+{
+    return m_data->model;
+}
+
+void QskModelListView::setColumnWidthHint( int column, qreal width )
+{
+    if ( column < 0 )
+        return;
+
+    auto& hints = m_data->columnWidthHints;
+
+    if ( column >= hints.size() )
+    {
+        if ( width <= 0.0 )
+            return;
+
+        hints.resize( column + 1 );
+    }
+
+    width = qMax( width, qreal( 0.0 ) );
+
+    if ( width != hints[ column ] )
+    {
+        hints[ column ] = width;
+
+        m_data->isSizeDirty = true;
+        polish();
+    }
+}
+
+qreal QskModelListView::columnWidthHint( int column ) const
+{
+    return m_data->columnWidthHints.value( column, 0.0 );
+}
+
+int QskModelListView::rowCount() const
+{
+    const auto model = m_data->model.data();
+    return model ? model->rowCount() : 0;
+}
+
+int QskModelListView::columnCount() const
+{
+    const auto model = m_data->model.data();
+    return model ? model->columnCount() : 0;
+}
+
+qreal QskModelListView::columnWidth( int col ) const
+{
+    if ( col < 0 || col >= columnCount() )
+        return 0.0;
+
+    auto w = columnWidthHint( col );
+    if ( w <= 0.0 )
+    {
+        const auto padding = paddingHint( Cell );
+
+        w = m_data->textWidths.value( col, 0.0 );
+        w += padding.left() + padding.right();
+    }
+
+    return w;
+}
+
+qreal QskModelListView::rowHeight() const
+{
+    const auto hint = strutSizeHint( Cell );
+    const auto padding = paddingHint( Cell );
+
+    qreal h = effectiveFontHeight( Text );
+    h += padding.top() + padding.bottom();
+
+    return qMax( h, hint.height() );
+}
+
+QVariant QskModelListView::valueAt( int row, int col ) const
+{
+    if ( const auto model = m_data->model.data() )
+        return model->data( model->index( row, col ), Qt::DisplayRole );
+
+    return QVariant();
+}
+
+void QskModelListView::resetModelRows()
+{
+    m_data->isModelDirty = true;
+    polish();
+}
+
+void QskModelListView::insertModelRows( int first, int last )
+{
+    const auto count = last - first + 1;
+
+    const auto row = selectedRow();
+    if ( row >= first )
+        setSelectedRow( row + count );
+
+    m_data->addMeasuredRows( first, last );
+
+    // all rows below are shifted
+    m_data->addAffectedRows( first, std::numeric_limits< int >::max() );
+    m_data->isSizeDirty = true;
+
+    polish();
+}
+
+void QskModelListView::removeModelRows( int first, int last )
+{
+    auto row = selectedRow();
+    if ( row >= first )
+    {
+        if ( row > last )
+            row -= last - first + 1;
+        else
+            row = qMin( first, rowCount() - 1 );
+
+        setSelectedRow( row );
+    }
+
+    /*
+        We do not remeasure the remaining rows, as this might
+        be expensive. So the column widths are not shrinking.
+     */
+
+    m_data->addAffectedRows( first, std::numeric_limits< int >::max() );
+    m_data->isSizeDirty = true;
+
+    polish();
+}
+
+void QskModelListView::changeModelRows( int first, int last )
+{
+    m_data->addMeasuredRows( first, last );
+    m_data->addAffectedRows( first, last );
+
+    if ( hasVariableRowHeights() )
+    {
+        for ( int row = first; row <= last; row++ )
+            updateRowHeight( row );
+    }
+
+    polish();
+}
+
+void QskModelListView::changeEvent( QEvent* event )
+{
+    if ( event->type() == QEvent::StyleChange )
+        resetModelRows(); // the fonts might have changed
+
+    Inherited::changeEvent( event );
+}
+
+void QskModelListView::updateResources()
+{
+    Inherited::updateResources();
+
+    const auto rowCount = this->rowCount();
+    const auto columnCount = this->columnCount();
+
+    auto& textWidths = m_data->textWidths;
+
+    if ( m_data->isModelDirty )
+    {
+        textWidths.fill( 0.0, columnCount );
+        m_data->measuredRanges = { RowRange { 0, rowCount - 1 } };
+        m_data->isSizeDirty = true;
+    }
+    else if ( textWidths.size() != columnCount )
+    {
+        textWidths.resize( columnCount );
+    }
+
+    if ( !m_data->measuredRanges.isEmpty() )
+    {
+        const QFontMetricsF fm( effectiveFont( Text ) );
+
+        for ( const auto& range : std::as_const( m_data->measuredRanges ) )
+        {
+            const auto last = qMin( range.last, rowCount - 1 );
+
+            for ( int col = 0; col < columnCount; col++ )
+            {
+                if ( columnWidthHint( col ) > 0.0 )
+                    continue;
+
+                for ( int row = qMax( range.first, 0 ); row <= last; row++ )
+                {
+                    const auto value = valueAt( row, col );
+                    if ( value.canConvert< QString >() )
+                    {
+                        const auto w = qskHorizontalAdvance( fm, value.toString() );
+                        if ( w > textWidths[ col ] )
+                        {
+                            textWidths[ col ] = w;
+                            m_data->isSizeDirty = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if ( m_data->isModelDirty )
+    {
+        updateScrollableSize();
+        updateAllRows();
+    }
+    else
+    {
+        if ( m_data->isSizeDirty )
+            updateScrollableSize(); // updates the scroll bars, when being modified
+
+        if ( m_data->affectedLast >= 0 )
+        {
+            // only the rows in the visible area are of interest
+
+            const auto y = scrollPos().y();
+
+            auto first = rowAt( y );
+            if ( first < 0 )
+                first = 0;
+
+            auto last = rowAt( y + viewContentsRect().height() );
+            if ( last < 0 )
+                last = rowCount - 1;
+
+            /*
+                Rows scrolling in later get new nodes anyway, so
+                we only need to report the visible ones
+             */
+            first = qMax( m_data->affectedFirst, first );
+            last = qMin( m_data->affectedLast, last );
+
+            if ( first <= last )
+                updateRows( first, last );
+        }
+    }
+
+    m_data->resetPending();
+}
+
+#include "moc_QskModelListView.cpp"
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_MODEL_LIST_VIEW_H
+#define QSK_MODEL_LIST_VIEW_H
+
+#include "QskListView.h"
+
+class QAbstractItemModel;
+
+/*
+    A list view displaying the Qt::DisplayRole of a QAbstractItemModel.
+
+    Changes of the model are processed incrementally: notifications are
+    collected and handled once per frame in the polish cycle, so that
+    models receiving hundreds of rows per second do not result in
+    recalculations for each of them. Only the scene graph nodes of
+    the modified rows in the visible area are updated.
+
+    As the columns widths are only increasing, when new rows are measured,
+    it is recommended to set fixed widths for huge or volatile models:
+    see setColumnWidthHint().
+ */
+class QSK_EXPORT QskModelListView : public QskListView
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QAbstractItemModel* model READ model
+        WRITE setModel NOTIFY modelChanged )
+
+    using Inherited = QskListView;
+
+  public:
+    QskModelListView( QQuickItem* parent = nullptr );
+    ~QskModelListView() override;
+
+    void setModel( QAbstractItemModel* );
+    QAbstractItemModel* model() const;
+
+    void setColumnWidthHint( int column, qreal width );
+    qreal columnWidthHint( int column ) const;
+
+    int rowCount() const override;
+    int columnCount() const override;
+
+    qreal columnWidth( int col ) const override;
+    qreal rowHeight() const override;
+
+    QVariant valueAt( int row, int col ) const override;
+
+  Q_SIGNALS:
+    void modelChanged();
+
+  protected:
+    void changeEvent( QEvent* ) override;
+    void updateResources() override;
+
+  private:
+    void resetModelRows();
+
+    void insertModelRows( int first, int last );
+    void removeModelRows( int first, int last );
+    void changeModelRows( int first, int last );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
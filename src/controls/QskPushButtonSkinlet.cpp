@@ -6,6 +6,7 @@
 #include "QskPushButtonSkinlet.h"
 #include "QskPushButton.h"
 #include "QskTextOptions.h"
+#include "QskPlainTextRenderer.h"
 
 #include "QskAnimationHint.h"
 #include "QskGraphic.h"
@@ -193,4 +194,22 @@ QSizeF QskPushButtonSkinlet::sizeHint( const QskSkinnable* skinnable,
     return size;
 }
 
+void QskPushButtonSkinlet::collectTexts( const QskSkinnable* skinnable,
+    QVector< QskPlainTextRenderer::TextRequest >& requests ) const
+{
+    using Q = QskPushButton;
+
+    const auto button = static_cast< const QskPushButton* >( skinnable );
+
+    const auto text = button->text();
+    if ( text.isEmpty() )
+        return;
+
+    // see QskSubcontrolLayoutEngine::TextElement
+    const auto textOptions = button->textOptionsHint( Q::Text );
+
+    if ( textOptions.effectiveFormat( text ) == QskTextOptions::PlainText )
+        requests += { text, button->effectiveFont( Q::Text ), textOptions };
+}
+
 #include "moc_QskPushButtonSkinlet.cpp"
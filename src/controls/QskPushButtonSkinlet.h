@@ -36,6 +36,9 @@ class QSK_EXPORT QskPushButtonSkinlet : public QskSkinlet
     QSizeF sizeHint( const QskSkinnable*,
         Qt::SizeHint, const QSizeF& ) const override;
 
+    void collectTexts( const QskSkinnable*,
+        QVector< QskPlainTextRenderer::TextRequest >& ) const override;
+
   protected:
     QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const override;
@@ -10,6 +10,14 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskSGNode.h"
 
+#include <qquickwindow.h>
+#include <qset.h>
+#include <qvector.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 #include <private/qquickitemchangelistener_p.h>
@@ -428,12 +436,239 @@ namespace
     }
 }
 
+namespace
+{
+    /*
+        The children of the scrolled item, sorted by their position along
+        the scrolling direction. The children intersecting an interval
+        are found by a binary search, so that scrolling does not need
+        to iterate over all children.
+
+        The index is invalidated, when children are added/removed or
+        their geometries change - f.e. when the scrolled item has
+        been laid out.
+     */
+    class VirtualizationIndex final : public QQuickItemChangeListener
+    {
+      public:
+        class Entry
+        {
+          public:
+            QRectF rect;
+            QskControl* control;
+            bool isVirtualized;
+        };
+
+        ~VirtualizationIndex() override
+        {
+            setItem( nullptr );
+        }
+
+        void setItem( QQuickItem* );
+        inline QQuickItem* item() const { return m_item; }
+
+        inline bool isDirty() const { return m_isDirty; }
+        void rebuild( Qt::Orientation );
+
+        // the entries [first, last[, that might intersect rect
+        void lookup( const QRectF& rect, int& first, int& last ) const;
+
+        inline int count() const { return m_entries.count(); }
+        inline Entry& entry( int index ) { return m_entries[ index ]; }
+
+        // called, when the index becomes dirty
+        std::function< void() > invalidated;
+
+        int virtualizedCount = 0;
+
+      protected:
+        void itemGeometryChanged( QQuickItem*,
+            QQuickGeometryChange, const QRectF& ) override
+        {
+            invalidate();
+        }
+
+        void itemChildAdded( QQuickItem*, QQuickItem* child ) override
+        {
+            listen( child, true );
+            invalidate();
+        }
+
+        void itemChildRemoved( QQuickItem*, QQuickItem* child ) override
+        {
+            listen( child, false );
+            invalidate();
+        }
+
+        void itemDestroyed( QQuickItem* item ) override
+        {
+            if ( item == m_item )
+            {
+                m_item = nullptr;
+                clear();
+            }
+        }
+
+      private:
+        void listen( QQuickItem* child, bool on )
+        {
+            auto d = QQuickItemPrivate::get( child );
+
+            if ( on )
+                d->addItemChangeListener( this, QQuickItemPrivate::Geometry );
+            else
+                d->removeItemChangeListener( this, QQuickItemPrivate::Geometry );
+        }
+
+        inline void invalidate()
+        {
+            if ( !m_isDirty )
+            {
+                m_isDirty = true;
+
+                if ( invalidated )
+                    invalidated();
+            }
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_maxEnds.clear();
+
+            virtualizedCount = 0;
+            m_isDirty = true;
+        }
+
+        inline qreal start( const QRectF& rect ) const
+        {
+            return ( m_orientation == Qt::Vertical ) ? rect.top() : rect.left();
+        }
+
+        inline qreal end( const QRectF& rect ) const
+        {
+            return ( m_orientation == Qt::Vertical ) ? rect.bottom() : rect.right();
+        }
+
+        QQuickItem* m_item = nullptr;
+
+        QVector< Entry > m_entries;  // sorted by start()
+        QVector< qreal > m_maxEnds;  // the maximum of end() for [0, i]
+
+        Qt::Orientation m_orientation = Qt::Vertical;
+        bool m_isDirty = true;
+    };
+
+    void VirtualizationIndex::setItem( QQuickItem* item )
+    {
+        if ( item == m_item )
+            return;
+
+        const QQuickItemPrivate::ChangeTypes types =
+            QQuickItemPrivate::Children | QQuickItemPrivate::Destroyed;
+
+        if ( m_item )
+        {
+            const auto children = m_item->childItems();
+            for ( auto child : children )
+                listen( child, false );
+
+            QQuickItemPrivate::get( m_item )->removeItemChangeListener( this, types );
+        }
+
+        m_item = item;
+        clear();
+
+        if ( m_item )
+        {
+            QQuickItemPrivate::get( m_item )->addItemChangeListener( this, types );
+
+            const auto children = m_item->childItems();
+            for ( auto child : children )
+                listen( child, true );
+        }
+    }
+
+    void VirtualizationIndex::rebuild( Qt::Orientation orientation )
+    {
+        /*
+            The entries might refer to deleted children, so the
+            old state is looked up by address only
+         */
+        QSet< const QskControl* > virtualized;
+        virtualized.reserve( virtualizedCount );
+
+        for ( const auto& entry : std::as_const( m_entries ) )
+        {
+            if ( entry.isVirtualized )
+                virtualized.insert( entry.control );
+        }
+
+        m_entries.clear();
+        virtualizedCount = 0;
+
+        if ( m_item )
+        {
+            const auto children = m_item->childItems();
+            m_entries.reserve( children.count() );
+
+            for ( auto child : children )
+            {
+                if ( auto control = qskControlCast( child ) )
+                {
+                    const bool isVirtualized = virtualized.contains( control );
+                    if ( isVirtualized )
+                        virtualizedCount++;
+
+                    m_entries += Entry{ qskItemGeometry( control ), control, isVirtualized };
+                }
+            }
+        }
+
+        m_orientation = orientation;
+
+        std::sort( m_entries.begin(), m_entries.end(),
+            [ this ]( const Entry& e1, const Entry& e2 )
+            { return start( e1.rect ) < start( e2.rect ); } );
+
+        m_maxEnds.resize( m_entries.count() );
+
+        qreal maxEnd = std::numeric_limits< qreal >::lowest();
+        for ( int i = 0; i < m_entries.count(); i++ )
+        {
+            maxEnd = qMax( maxEnd, end( m_entries[ i ].rect ) );
+            m_maxEnds[ i ] = maxEnd;
+        }
+
+        m_isDirty = false;
+    }
+
+    void VirtualizationIndex::lookup( const QRectF& rect, int& first, int& last ) const
+    {
+        const auto from = start( rect );
+        const auto to = end( rect );
+
+        // all entries before first end before the interval
+        first = std::lower_bound( m_maxEnds.constBegin(),
+            m_maxEnds.constEnd(), from ) - m_maxEnds.constBegin();
+
+        // all entries from last on start after the interval
+        last = std::upper_bound( m_entries.constBegin(), m_entries.constEnd(), to,
+            [ this ]( qreal value, const Entry& entry )
+            { return value < start( entry.rect ); } ) - m_entries.constBegin();
+
+        last = qMax( first, last );
+    }
+}
+
 class QskScrollArea::PrivateData
 {
   public:
     PrivateData()
         : isItemResizable( true )
         , isItemFocusClipping( true )
+        , isItemVirtualization( false )
+        , isVirtualizationPending( false )
     {
     }
 
@@ -451,10 +686,54 @@ class QskScrollArea::PrivateData
         }
     }
 
+    void scheduleVirtualization( QskScrollArea* scrollArea )
+    {
+        if ( !isItemVirtualization || isVirtualizationPending )
+            return;
+
+        auto window = scrollArea->window();
+        if ( window == nullptr )
+            return;
+
+        /*
+            The children of the scrolled item will be laid out, when
+            it is polished - what happens after we have been polished.
+            afterAnimating is emitted, when all items have been polished,
+            but before the scene graph is synchronized. So the nodes of
+            children outside of the viewport are not even created.
+         */
+        isVirtualizationPending = true;
+
+        virtualizationConnection = QObject::connect(
+            window, &QQuickWindow::afterAnimating,
+            scrollArea, [ scrollArea ]() { scrollArea->updateVirtualization(); } );
+
+        window->update();
+    }
+
     ClipItem* clipItem = nullptr;
 
+    // the children and if they have been hidden by the virtualization
+    VirtualizationIndex virtualizationIndex;
+    qreal virtualizationMargin = 0.0;
+
+    /*
+        The viewport of the last pass extended by the band. As long
+        as the viewport stays inside, no child can have entered the
+        extended viewport.
+     */
+    QRectF virtualizationBand;
+
+    // the entries, that have been inside of the extended viewport
+    int liveFirst = 0;
+    int liveLast = 0;
+
+    QMetaObject::Connection virtualizationConnection;
+
     bool isItemResizable : 1;
     bool isItemFocusClipping : 1;
+    bool isItemVirtualization : 1;
+    bool isVirtualizationPending : 1;
 };
 
 
@@ -467,11 +746,17 @@ QskScrollArea::QskScrollArea( QQuickItem* parentItem )
     m_data->clipItem = new ClipItem( this );
     m_data->enableAutoTranslation( this, true );
 
+    m_data->virtualizationIndex.invalidated =
+        [ this ]() { m_data->scheduleVirtualization( this ); };
+
     initSizePolicy( QskSizePolicy::Ignored, QskSizePolicy::Ignored );
 }
 
 QskScrollArea::~QskScrollArea()
 {
+    // the scrolled item might survive the scroll area
+    resetVirtualization();
+
     delete m_data->clipItem;
 }
 
@@ -481,7 +766,12 @@ void QskScrollArea::updateLayout()
 
     // the clipItem always has the same geometry as the scroll area
     m_data->clipItem->setSize( size() );
+
+    // the size of the viewport might change
+    m_data->virtualizationBand = QRectF();
+
     adjustItem();
+    m_data->scheduleVirtualization( this );
 }
 
 QSizeF QskScrollArea::layoutSizeHint( Qt::SizeHint which, const QSizeF& constraint  ) const
@@ -601,6 +891,8 @@ void QskScrollArea::setScrolledItem( QQuickItem* item )
 
     if ( oldItem )
     {
+        resetVirtualization();
+
         if ( oldItem->parent() == this )
             delete oldItem;
         else
@@ -629,7 +921,257 @@ void QskScrollArea::translateItem()
     {
         const QPointF pos = viewContentsRect().topLeft() - scrollPos();
         item->setPosition( pos );
+
+        if ( m_data->isItemVirtualization )
+            updateVirtualization();
+    }
+}
+
+void QskScrollArea::setItemVirtualization( bool on )
+{
+    if ( on == m_data->isItemVirtualization )
+        return;
+
+    m_data->isItemVirtualization = on;
+
+    if ( on )
+        updateVirtualization();
+    else
+        resetVirtualization();
+
+    Q_EMIT itemVirtualizationChanged( on );
+}
+
+bool QskScrollArea::hasItemVirtualization() const
+{
+    return m_data->isItemVirtualization;
+}
+
+void QskScrollArea::setVirtualizationMargin( qreal margin )
+{
+    margin = qMax( margin, 0.0 );
+
+    if ( margin != m_data->virtualizationMargin )
+    {
+        m_data->virtualizationMargin = margin;
+        m_data->virtualizationBand = QRectF();
+
+        if ( m_data->isItemVirtualization )
+            updateVirtualization();
+
+        Q_EMIT virtualizationMarginChanged( margin );
+    }
+}
+
+qreal QskScrollArea::virtualizationMargin() const
+{
+    return m_data->virtualizationMargin;
+}
+
+int QskScrollArea::liveItemCount() const
+{
+    int count = 0;
+
+    if ( auto item = scrolledItem() )
+        count = item->childItems().count() - virtualizedItemCount();
+
+    return count;
+}
+
+int QskScrollArea::virtualizedItemCount() const
+{
+    return m_data->virtualizationIndex.virtualizedCount;
+}
+
+/*
+    Virtualized children are hidden by setting their effective visibility
+    only. As the explicit visibility ( isVisibleToParent ) does not change,
+    layouts keep reserving space for them without having to modify
+    their placement policies. It also allows to detect when the
+    application hides a virtualized child - it will not be shown again.
+ */
+static inline void qskSetVirtualized( QskControl* control, bool on )
+{
+    auto d = QQuickItemPrivate::get( control );
+
+    if ( on )
+        d->setEffectiveVisibleRecur( false );
+    else
+        d->setEffectiveVisibleRecur( d->calcEffectiveVisible() );
+}
+
+static inline const QQuickItem* qskFocusChild( const QQuickItem* item )
+{
+    // the child of item, that contains the active focus item
+
+    if ( const auto window = item->window() )
+    {
+        for ( auto focusItem = window->activeFocusItem();
+            focusItem != nullptr; focusItem = focusItem->parentItem() )
+        {
+            if ( focusItem->parentItem() == item )
+                return focusItem;
+        }
+    }
+
+    return nullptr;
+}
+
+static void qskUpdateVirtualization( VirtualizationIndex& index, int first, int last,
+    const QRectF& liveRect, const QQuickItem* focusChild )
+{
+    for ( int i = first; i < last; i++ )
+    {
+        auto& entry = index.entry( i );
+        auto control = entry.control;
+
+        bool isVirtualized = entry.isVirtualized;
+
+        if ( !control->isVisibleToParent() )
+        {
+            // hidden by the application
+            isVirtualized = false;
+        }
+        else if ( isVirtualized || control->isVisible() )
+        {
+            /*
+                Hiding an item with the active focus would drop the focus,
+                only because of scrolling.
+             */
+            const bool isInside = entry.rect.intersects( liveRect )
+                || ( control == focusChild );
+
+            if ( isInside )
+            {
+                if ( isVirtualized && !control->isVisible() )
+                    qskSetVirtualized( control, false );
+
+                isVirtualized = false;
+            }
+            else
+            {
+                /*
+                    A virtualized child might have become visible again, when
+                    the effective visibility has been recalculated by Qt,
+                    f.e. because the scrolled item has been shown.
+                 */
+                if ( control->isVisible() )
+                    qskSetVirtualized( control, true );
+
+                isVirtualized = true;
+            }
+        }
+
+        if ( isVirtualized != entry.isVirtualized )
+        {
+            entry.isVirtualized = isVirtualized;
+            index.virtualizedCount += isVirtualized ? 1 : -1;
+        }
+    }
+}
+
+void QskScrollArea::updateVirtualization()
+{
+    if ( m_data->isVirtualizationPending )
+    {
+        QObject::disconnect( m_data->virtualizationConnection );
+        m_data->isVirtualizationPending = false;
+    }
+
+    const auto item = scrolledItem();
+    if ( item == nullptr || !m_data->isItemVirtualization )
+        return;
+
+    auto& index = m_data->virtualizationIndex;
+    index.setItem( item );
+
+    const auto viewRect = QRectF( scrollPos(), viewContentsRect().size() );
+
+    if ( !index.isDirty() && m_data->virtualizationBand.contains( viewRect ) )
+        return;
+
+    /*
+        Children are made live, when they are inside of the viewport
+        extended by the margin and a band of half of the viewport size.
+        As long as the viewport stays inside of the band, nothing has
+        to be done.
+     */
+    const auto bw = 0.5 * viewRect.width();
+    const auto bh = 0.5 * viewRect.height();
+
+    const auto m = m_data->virtualizationMargin;
+
+    const auto bandRect = viewRect.adjusted( -bw, -bh, bw, bh );
+    const auto liveRect = bandRect.adjusted( -m, -m, m, m );
+
+    const auto focusChild = qskFocusChild( item );
+
+    if ( index.isDirty() )
+    {
+        const auto orientation =
+            ( item->height() - viewRect.height() >= item->width() - viewRect.width() )
+            ? Qt::Vertical : Qt::Horizontal;
+
+        index.rebuild( orientation );
+
+        qskUpdateVirtualization( index, 0, index.count(), liveRect, focusChild );
+        index.lookup( liveRect, m_data->liveFirst, m_data->liveLast );
+    }
+    else
+    {
+        /*
+            Children outside of the previous and the current range are
+            virtualized already - beside the one with the focus,
+            that would be hidden again with the next rebuild.
+         */
+        int first, last;
+        index.lookup( liveRect, first, last );
+
+        qskUpdateVirtualization( index,
+            m_data->liveFirst, m_data->liveLast, liveRect, focusChild );
+
+        qskUpdateVirtualization( index, first, last, liveRect, focusChild );
+
+        m_data->liveFirst = first;
+        m_data->liveLast = last;
+    }
+
+    m_data->virtualizationBand = bandRect;
+}
+
+void QskScrollArea::resetVirtualization()
+{
+    if ( m_data->isVirtualizationPending )
+    {
+        QObject::disconnect( m_data->virtualizationConnection );
+        m_data->isVirtualizationPending = false;
     }
+
+    auto& index = m_data->virtualizationIndex;
+
+    if ( index.virtualizedCount > 0 )
+    {
+        if ( index.isDirty() )
+            index.rebuild( Qt::Vertical );
+
+        for ( int i = 0; i < index.count(); i++ )
+        {
+            const auto& entry = index.entry( i );
+
+            if ( entry.isVirtualized )
+            {
+                auto control = entry.control;
+
+                if ( control->isVisibleToParent() && !control->isVisible() )
+                    qskSetVirtualized( control, false );
+            }
+        }
+    }
+
+    index.setItem( nullptr );
+
+    m_data->virtualizationBand = QRectF();
+    m_data->liveFirst = m_data->liveLast = 0;
 }
 
 #ifndef QT_NO_WHEELEVENT
@@ -21,6 +21,12 @@ class QSK_EXPORT QskScrollArea : public QskScrollView
     Q_PROPERTY( bool itemFocusClipping READ hasItemFocusClipping
         WRITE setItemFocusClipping FINAL )
 
+    Q_PROPERTY( bool itemVirtualization READ hasItemVirtualization
+        WRITE setItemVirtualization NOTIFY itemVirtualizationChanged FINAL )
+
+    Q_PROPERTY( qreal virtualizationMargin READ virtualizationMargin
+        WRITE setVirtualizationMargin NOTIFY virtualizationMarginChanged FINAL )
+
     using Inherited = QskScrollView;
 
   public:
@@ -36,9 +42,33 @@ class QSK_EXPORT QskScrollArea : public QskScrollView
     void setItemFocusClipping( bool on );
     bool hasItemFocusClipping() const;
 
+    /*
+        When item virtualization is enabled, the children of the scrolled item,
+        that are outside of the viewport ( extended by the virtualization margin ),
+        are hidden. Their space is still reserved and they are still positioned
+        by layouts, but their nodes are released ( CleanupOnVisibility )
+        and polishing/updating is deferred.
+
+        Virtualized children are not visible, but remain visible to their
+        parent ( QskItem::isVisibleToParent ). Children hidden by the application
+        and the child with the active focus are never virtualized.
+
+        Only children being derived from QskControl are virtualized.
+     */
+    void setItemVirtualization( bool on );
+    bool hasItemVirtualization() const;
+
+    void setVirtualizationMargin( qreal );
+    qreal virtualizationMargin() const;
+
+    int liveItemCount() const;
+    int virtualizedItemCount() const;
+
   Q_SIGNALS:
     void scrolledItemChanged();
     void itemResizableChanged( bool );
+    void itemVirtualizationChanged( bool );
+    void virtualizationMarginChanged( qreal );
 
   protected:
     void updateLayout() override;
@@ -52,6 +82,9 @@ class QSK_EXPORT QskScrollArea : public QskScrollView
     void translateItem();
     void adjustItem();
 
+    void updateVirtualization();
+    void resetVirtualization();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
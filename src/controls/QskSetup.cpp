@@ -17,6 +17,15 @@ namespace
         if ( !qskHasEnvironment( "QSK_PREFER_FBO_PAINTING" ) )
             flags |= QskItem::PreferRasterForTextures;
 
+        if ( qskHasEnvironment( "QSK_PREFER_TEXTURE_ATLAS" ) )
+            flags |= QskItem::PreferTextureAtlas;
+
+        if ( qskHasEnvironment( "QSK_ASYNCHRONOUS_TEXTURES" ) )
+            flags |= QskItem::AsynchronousTextures;
+
+        if ( qskHasEnvironment( "QSK_OFFSCREEN_CULLING" ) )
+            flags |= QskItem::DeferredOffscreenUpdate;
+
         if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
             flags |= QskItem::DebugForceBackground;
 
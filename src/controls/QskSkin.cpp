@@ -258,6 +258,7 @@ void QskSkin::setColorScheme( ColorScheme colorScheme )
 
         clearHints();
         initHints();
+        m_data->hintTable.compile();
 
         transition.setTargetSkin( this );
         transition.run( transitionHint );
@@ -266,6 +267,7 @@ void QskSkin::setColorScheme( ColorScheme colorScheme )
     {
         clearHints();
         initHints();
+        m_data->hintTable.compile();
     }
 
     Q_EMIT colorSchemeChanged( colorScheme );
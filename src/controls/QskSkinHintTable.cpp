@@ -6,10 +6,24 @@
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
 
+#include <qalgorithms.h>
+#include <qvector.h>
+
+#include <algorithm>
 #include <limits>
 
 const QVariant QskSkinHintTable::invalidHint;
 
+static quint64 qskNextGeneration()
+{
+    /*
+        Hint tables are modified from the GUI thread only,
+        so we don't need to care about atomics here.
+     */
+    static quint64 generation = 0;
+    return ++generation;
+}
+
 inline const QVariant* qskResolvedHint( QskAspect aspect,
     const QHash< QskAspect, QVariant >& hints, QskAspect* resolvedAspect )
 {
@@ -69,12 +83,210 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
     }
 }
 
+static inline quint16 qskStateMask( QskAspect::States states )
+{
+    // all state bits up to and including the top state
+
+    const auto bits = static_cast< quint16 >( states );
+    return bits ? ( 0xffff >> qCountLeadingZeroBits( bits ) ) : 0;
+}
+
+class QskSkinHintTable::CompiledData
+{
+  public:
+    CompiledData( const QHash< QskAspect, QVariant >& hints )
+    {
+        m_entries.reserve( hints.size() );
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const Entry entry = { it.key(), qskStateMask( it.key().states() ), it.value() };
+            m_entries += entry;
+        }
+
+        /*
+            Grouping the entries by their stateless aspect. Inside of a group
+            the entries are ordered by their states in descending order,
+            so that the first match is the one, that qskResolvedHint
+            would have found when dropping the state bits one by one.
+         */
+
+        std::sort( m_entries.begin(), m_entries.end(),
+            []( const Entry& e1, const Entry& e2 )
+            {
+                const auto s1 = e1.aspect.stateless().value();
+                const auto s2 = e2.aspect.stateless().value();
+
+                if ( s1 != s2 )
+                    return s1 < s2;
+
+                return static_cast< quint16 >( e1.aspect.states() )
+                    > static_cast< quint16 >( e2.aspect.states() );
+            } );
+
+        int groupCount = 0;
+        for ( int i = 0; i < m_entries.size(); i++ )
+        {
+            if ( i == 0 || m_entries[ i ].aspect.stateless()
+                != m_entries[ i - 1 ].aspect.stateless() )
+            {
+                groupCount++;
+            }
+        }
+
+        int capacity = 8;
+        while ( capacity < 2 * groupCount )
+            capacity *= 2;
+
+        m_slotMask = capacity - 1;
+        const Slot emptySlot = { EmptySlot, 0, 0 };
+        m_slots.fill( emptySlot, capacity );
+
+        for ( int i = 0; i < m_entries.size(); )
+        {
+            const auto stem = m_entries[ i ].aspect.stateless().value();
+
+            int count = 1;
+            while ( i + count < m_entries.size()
+                && m_entries[ i + count ].aspect.stateless().value() == stem )
+            {
+                count++;
+            }
+
+            auto index = slotIndex( stem );
+            while ( m_slots[ index ].stem != EmptySlot )
+                index = ( index + 1 ) & m_slotMask;
+
+            const Slot slot = { stem, i, count };
+            m_slots[ index ] = slot;
+
+            i += count;
+        }
+    }
+
+    const QVariant* resolvedHint( QskAspect aspect, QskAspect* resolvedAspect ) const
+    {
+        /*
+            The fallback chain of qskResolvedHint visits the variation/section
+            combinations in the order below. For each of them we only need
+            to find the first entry matching the states.
+         */
+
+        const auto states = static_cast< quint16 >( aspect.states() );
+
+        auto stem = aspect.stateless();
+
+        if ( auto entry = find( stem, states ) )
+            return value( entry, resolvedAspect );
+
+        if ( stem.variation() )
+        {
+            auto a = stem;
+            a.setVariation( QskAspect::NoVariation );
+
+            if ( auto entry = find( a, states ) )
+                return value( entry, resolvedAspect );
+        }
+
+        if ( stem.section() != QskAspect::Body )
+        {
+            stem.setSection( QskAspect::Body );
+
+            if ( auto entry = find( stem, states ) )
+                return value( entry, resolvedAspect );
+
+            if ( stem.variation() )
+            {
+                stem.setVariation( QskAspect::NoVariation );
+
+                if ( auto entry = find( stem, states ) )
+                    return value( entry, resolvedAspect );
+            }
+        }
+
+        return nullptr;
+    }
+
+  private:
+    struct Entry
+    {
+        QskAspect aspect;
+        quint16 stateMask;
+        QVariant value;
+    };
+
+    struct Slot
+    {
+        quint64 stem;
+
+        int from;
+        int count;
+    };
+
+    // the reserved bits are never set for valid aspects
+    static constexpr quint64 EmptySlot = std::numeric_limits< quint64 >::max();
+
+    inline int slotIndex( quint64 stem ) const
+    {
+        // fibonacci hashing
+        return static_cast< int >(
+            ( stem * Q_UINT64_C( 0x9E3779B97F4A7C15 ) ) >> 32 ) & m_slotMask;
+    }
+
+    inline const Entry* find( QskAspect stem, quint16 states ) const
+    {
+        const auto key = stem.value();
+
+        for ( auto index = slotIndex( key ); ; index = ( index + 1 ) & m_slotMask )
+        {
+            const auto& slot = m_slots[ index ];
+
+            if ( slot.stem == EmptySlot )
+                return nullptr;
+
+            if ( slot.stem == key )
+            {
+                const auto entries = m_entries.constData() + slot.from;
+
+                for ( int i = 0; i < slot.count; i++ )
+                {
+                    const auto& entry = entries[ i ];
+
+                    if ( ( states & entry.stateMask )
+                        == static_cast< quint16 >( entry.aspect.states() ) )
+                    {
+                        return &entry;
+                    }
+                }
+
+                return nullptr;
+            }
+        }
+    }
+
+    static inline const QVariant* value(
+        const Entry* entry, QskAspect* resolvedAspect )
+    {
+        if ( resolvedAspect )
+            *resolvedAspect = entry->aspect;
+
+        return &entry->value;
+    }
+
+    QVector< Entry > m_entries;
+    QVector< Slot > m_slots;
+    int m_slotMask = 0;
+};
+
 QskSkinHintTable::QskSkinHintTable()
+    : m_generation( qskNextGeneration() )
 {
 }
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
-    : m_animatorCount( other.m_animatorCount )
+    : m_generation( qskNextGeneration() )
+    , m_compiled( other.m_compiled )
+    , m_animatorCount( other.m_animatorCount )
     , m_states( other.m_states )
 {
     if ( other.m_hints )
@@ -102,6 +314,8 @@ QskSkinHintTable::~QskSkinHintTable()
 
 QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
 {
+    invalidate();
+
     m_animatorCount = ( other.m_animatorCount );
     m_states = other.m_states;
 
@@ -111,6 +325,8 @@ QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
     if ( other.m_hints )
         m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
 
+    m_compiled = other.m_compiled;
+
     return *this;
 }
 
@@ -125,8 +341,22 @@ const QHash< QskAspect, QVariant >& QskSkinHintTable::hints() const
 
 #define QSK_ASSERT_COUNTER( x ) Q_ASSERT( x < std::numeric_limits< decltype( x ) >::max() )
 
+void QskSkinHintTable::invalidate()
+{
+    /*
+        Any non const access to m_hints might detach the hash
+        and relocate its values. So even when no hint is changing
+        we have to invalidate all pointers, that might have
+        been cached by the resolvers.
+     */
+    m_generation = qskNextGeneration();
+    m_compiled.reset();
+}
+
 bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 {
+    invalidate();
+
     if ( m_hints == nullptr )
         m_hints = new QHash< QskAspect, QVariant >();
 
@@ -162,6 +392,8 @@ bool QskSkinHintTable::removeHint( QskAspect aspect )
     if ( m_hints == nullptr )
         return false;
 
+    invalidate();
+
     const bool erased = m_hints->remove( aspect );
 
     if ( erased )
@@ -185,6 +417,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 {
     if ( m_hints )
     {
+        invalidate();
+
         auto it = m_hints->find( aspect );
         if ( it != m_hints->end() )
         {
@@ -211,6 +445,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 
 void QskSkinHintTable::clear()
 {
+    invalidate();
+
     delete m_hints;
     m_hints = nullptr;
 
@@ -218,9 +454,20 @@ void QskSkinHintTable::clear()
     m_states = QskAspect::NoState;
 }
 
+void QskSkinHintTable::compile()
+{
+    if ( m_hints )
+        m_compiled = std::make_shared< const CompiledData >( *m_hints );
+    else
+        m_compiled.reset();
+}
+
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
+    if ( m_compiled )
+        return m_compiled->resolvedHint( aspect & m_states, resolvedAspect );
+
     if ( m_hints != nullptr )
         return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
 
@@ -231,7 +478,9 @@ QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
     QskAspect a;
 
-    if ( m_hints != nullptr )
+    if ( m_compiled )
+        m_compiled->resolvedHint( aspect & m_states, &a );
+    else if ( m_hints != nullptr )
         qskResolvedHint( aspect & m_states, *m_hints, &a );
 
     return a;
@@ -246,7 +495,7 @@ QskAspect QskSkinHintTable::resolvedAnimator(
 
         Q_FOREVER
         {
-            auto it = m_hints->find( aspect );
+            auto it = m_hints->constFind( aspect );
             if ( it != m_hints->cend() )
             {
                 hint = it.value().value< QskAnimationHint >();
@@ -11,6 +11,8 @@
 #include <qvariant.h>
 #include <qhash.h>
 
+#include <memory>
+
 class QskAnimationHint;
 
 class QSK_EXPORT QskSkinHintTable
@@ -45,6 +47,15 @@ class QSK_EXPORT QskSkinHintTable
 
     void clear();
 
+    /*
+        Once all hints have been set, the table can be compiled into
+        a flat lookup structure with precalculated fallback chains,
+        that speeds up resolvedHint. Any modification of the table
+        drops the compiled data again.
+     */
+    void compile();
+    bool isCompiled() const;
+
     const QVariant* resolvedHint( QskAspect,
         QskAspect* resolvedAspect = nullptr ) const;
 
@@ -55,11 +66,23 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    /*
+        A value, that changes whenever the table has been modified.
+        Generations are unique across all tables, so that caches
+        of resolved hints can be validated by a simple comparison.
+     */
+    quint64 generation() const;
+
   private:
+    void invalidate();
 
     static const QVariant invalidHint;
 
     QHash< QskAspect, QVariant >* m_hints = nullptr;
+    quint64 m_generation = 0;
+
+    class CompiledData;
+    std::shared_ptr< const CompiledData > m_compiled;
 
     unsigned short m_animatorCount = 0;
     QskAspect::States m_states;
@@ -75,6 +98,16 @@ inline QskAspect::States QskSkinHintTable::states() const
     return m_states;
 }
 
+inline bool QskSkinHintTable::isCompiled() const
+{
+    return m_compiled != nullptr;
+}
+
+inline quint64 QskSkinHintTable::generation() const
+{
+    return m_generation;
+}
+
 inline bool QskSkinHintTable::hasAnimators() const
 {
     return m_animatorCount > 0;
@@ -125,13 +125,20 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( graphicNode == nullptr )
         graphicNode = new QskGraphicNode();
 
-    const auto flag = QskItem::PreferRasterForTextures;
+    bool useRaster = QskSetup::testUpdateFlag( QskItem::PreferRasterForTextures );
+    bool useAtlas = QskSetup::testUpdateFlag( QskItem::PreferTextureAtlas );
+    bool useAsync = QskSetup::testUpdateFlag( QskItem::AsynchronousTextures );
 
-    bool useRaster = QskSetup::testUpdateFlag( flag );
     if ( auto qItem = qobject_cast< const QskItem* >( item ) )
-        useRaster = qItem->testUpdateFlag( flag );
+    {
+        useRaster = qItem->testUpdateFlag( QskItem::PreferRasterForTextures );
+        useAtlas = qItem->testUpdateFlag( QskItem::PreferTextureAtlas );
+        useAsync = qItem->testUpdateFlag( QskItem::AsynchronousTextures );
+    }
 
     graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
+    graphicNode->setAtlasEnabled( useAtlas );
+    graphicNode->setAsynchronous( useAsync );
 
     graphicNode->setMirrored( mirrored );
 
@@ -30,6 +30,11 @@ class QskBoxHints;
 
 class QSGNode;
 
+namespace QskPlainTextRenderer
+{
+    class TextRequest;
+}
+
 class QSK_EXPORT QskSkinlet
 {
     Q_GADGET
@@ -45,6 +50,14 @@ class QSK_EXPORT QskSkinlet
     virtual QSizeF sizeHint( const QskSkinnable*,
         Qt::SizeHint, const QSizeF& ) const;
 
+    /*
+        Appends the plain texts, that are measured for the unconstrained
+        size hints, so that they can be measured in advance.
+        See QskLayoutEngine2D::setParallelMeasuring()
+     */
+    virtual void collectTexts( const QskSkinnable*,
+        QVector< QskPlainTextRenderer::TextRequest >& ) const;
+
     virtual QRectF subControlRect( const QskSkinnable*,
         const QRectF&, QskAspect::Subcontrol ) const;
 
@@ -206,6 +219,11 @@ inline QSizeF QskSkinlet::sizeHint(
     return QSizeF();
 }
 
+inline void QskSkinlet::collectTexts( const QskSkinnable*,
+    QVector< QskPlainTextRenderer::TextRequest >& ) const
+{
+}
+
 inline QRectF QskSkinlet::sampleRect( const QskSkinnable*,
     const QRectF&, QskAspect::Subcontrol, int index ) const
 {
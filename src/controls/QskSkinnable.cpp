@@ -11,6 +11,7 @@
 #include "QskColorFilter.h"
 #include "QskControl.h"
 #include "QskHintAnimator.h"
+#include "QskLayoutProfiler.h"
 #include "QskMargins.h"
 #include "QskSkinManager.h"
 #include "QskSkin.h"
@@ -32,6 +33,7 @@
 
 #include <qfont.h>
 #include <qfontmetrics.h>
+#include <qhash.h>
 #include <map>
 
 #define DEBUG_MAP 0
@@ -232,6 +234,76 @@ static inline QskAspect qskSubstitutedAspect(
     return aspect;
 }
 
+static QskSkinHintCacheStatistics qskHintCacheStatistics;
+
+namespace
+{
+    /*
+        Resolving a hint means a couple of lookups in the local and
+        the skin table while dropping state, variation and section bits.
+        As the result depends on the tables and the aspect ( including
+        the states ) only, we can remember it until one of the tables
+        has been modified or the skin has changed.
+     */
+    class HintCache
+    {
+      public:
+        struct Entry
+        {
+            const QVariant* value;
+            QskSkinHintStatus status;
+        };
+
+        inline void validate( const QskSkin* skin,
+            const QskSkinHintTable& localTable, const QskSkinHintTable& skinTable )
+        {
+            const auto localGeneration = localTable.generation();
+            const auto skinGeneration = skinTable.generation();
+
+            if ( skin != m_skin || localGeneration != m_localGeneration
+                || skinGeneration != m_skinGeneration )
+            {
+                if ( !m_entries.isEmpty() )
+                {
+                    m_entries.clear();
+                    qskHintCacheStatistics.invalidations++;
+                }
+
+                m_skin = skin;
+                m_localGeneration = localGeneration;
+                m_skinGeneration = skinGeneration;
+            }
+        }
+
+        inline const Entry* find( QskAspect aspect ) const
+        {
+            auto it = m_entries.constFind( aspect );
+            return ( it != m_entries.constEnd() ) ? &it.value() : nullptr;
+        }
+
+        inline void insert( QskAspect aspect,
+            const QVariant* value, const QskSkinHintStatus& status )
+        {
+            if ( m_entries.size() >= MaxEntries )
+            {
+                // should never happen for regular controls
+                m_entries.clear();
+            }
+
+            m_entries.insert( aspect, { value, status } );
+        }
+
+      private:
+        enum { MaxEntries = 512 };
+
+        QHash< QskAspect, Entry > m_entries;
+
+        const QskSkin* m_skin = nullptr;
+        quint64 m_localGeneration = 0;
+        quint64 m_skinGeneration = 0;
+    };
+}
+
 class QskSkinnable::PrivateData
 {
   public:
@@ -249,6 +321,8 @@ class QskSkinnable::PrivateData
     QskSkinHintTable hintTable;
     QskHintAnimatorTable animators;
 
+    HintCache hintCache;
+
     int sampleIndex = -1; // for the ugly QskSkinStateChanger hack
 
     typedef std::map< QskAspect::Subcontrol, QskAspect::Subcontrol > ProxyMap;
@@ -953,6 +1027,8 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
+    const QskLayoutProfiler::Scope scope( QskLayoutProfiler::HintResolution, this );
+
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
 
     if ( !( aspect.isAnimator() || aspect.hasStates() ) )
@@ -1122,6 +1198,35 @@ const QVariant& QskSkinnable::storedHint(
 {
     const auto skin = effectiveSkin();
 
+    auto& cache = m_data->hintCache;
+    cache.validate( skin, m_data->hintTable, skin->hintTable() );
+
+    if ( const auto entry = cache.find( aspect ) )
+    {
+        qskHintCacheStatistics.hits++;
+
+        if ( status )
+            *status = entry->status;
+
+        return *entry->value;
+    }
+
+    qskHintCacheStatistics.misses++;
+
+    QskSkinHintStatus resolvedStatus;
+    const auto& value = resolvedStoredHint( skin, aspect, resolvedStatus );
+
+    cache.insert( aspect, &value, resolvedStatus );
+
+    if ( status )
+        *status = resolvedStatus;
+
+    return value;
+}
+
+const QVariant& QskSkinnable::resolvedStoredHint( const QskSkin* skin,
+    QskAspect aspect, QskSkinHintStatus& status ) const
+{
     QskAspect resolvedAspect;
 
     const auto& localTable = m_data->hintTable;
@@ -1129,11 +1234,9 @@ const QVariant& QskSkinnable::storedHint(
     {
         if ( const auto value = localTable.resolvedHint( aspect, &resolvedAspect ) )
         {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skinnable;
-                status->aspect = resolvedAspect;
-            }
+            status.source = QskSkinHintStatus::Skinnable;
+            status.aspect = resolvedAspect;
+
             return *value;
         }
     }
@@ -1145,11 +1248,8 @@ const QVariant& QskSkinnable::storedHint(
     {
         if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
         {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skin;
-                status->aspect = resolvedAspect;
-            }
+            status.source = QskSkinHintStatus::Skin;
+            status.aspect = resolvedAspect;
 
             return *value;
         }
@@ -1163,27 +1263,31 @@ const QVariant& QskSkinnable::storedHint(
 
             if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
             {
-                if ( status )
-                {
-                    status->source = QskSkinHintStatus::Skin;
-                    status->aspect = resolvedAspect;
-                }
+                status.source = QskSkinHintStatus::Skin;
+                status.aspect = resolvedAspect;
 
                 return *value;
             }
         }
     }
 
-    if ( status )
-    {
-        status->source = QskSkinHintStatus::NoSource;
-        status->aspect = QskAspect();
-    }
+    status.source = QskSkinHintStatus::NoSource;
+    status.aspect = QskAspect();
 
     static QVariant hintInvalid;
     return hintInvalid;
 }
 
+QskSkinHintCacheStatistics QskSkinnable::hintCacheStatistics()
+{
+    return qskHintCacheStatistics;
+}
+
+void QskSkinnable::resetHintCacheStatistics()
+{
+    qskHintCacheStatistics = QskSkinHintCacheStatistics();
+}
+
 bool QskSkinnable::hasSkinState( QskAspect::State state ) const
 {
     return ( m_data->skinStates & state ) == state;
@@ -1566,6 +1670,7 @@ QskAspect::Section QskSkinnable::section() const
 
 void QskSkinnable::updateNode( QSGNode* parentNode )
 {
+    const QskLayoutProfiler::Scope scope( QskLayoutProfiler::UpdateNode, this );
     effectiveSkinlet()->updateNode( this, parentNode );
 }
 
@@ -1651,4 +1756,17 @@ QDebug operator<<( QDebug debug, const QskSkinHintStatus& status )
     return debug;
 }
 
+QDebug operator<<( QDebug debug, const QskSkinHintCacheStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "HintCache( hits: " << statistics.hits
+        << ", misses: " << statistics.misses
+        << ", hit rate: " << statistics.hitRate()
+        << ", invalidations: " << statistics.invalidations << " )";
+
+    return debug;
+}
+
 #endif
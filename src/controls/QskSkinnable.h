@@ -69,10 +69,25 @@ class QSK_EXPORT QskSkinHintStatus
     QskAspect aspect;
 };
 
+class QSK_EXPORT QskSkinHintCacheStatistics
+{
+  public:
+    inline qreal hitRate() const
+    {
+        const auto total = hits + misses;
+        return ( total > 0 ) ? qreal( hits ) / total : 0.0;
+    }
+
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 invalidations = 0;
+};
+
 #ifndef QT_NO_DEBUG_STREAM
 
 class QDebug;
 QSK_EXPORT QDebug operator<<( QDebug, const QskSkinHintStatus& );
+QSK_EXPORT QDebug operator<<( QDebug, const QskSkinHintCacheStatistics& );
 
 #endif
 
@@ -266,6 +281,9 @@ class QSK_EXPORT QskSkinnable
 
     const QskHintAnimator* runningHintAnimator( QskAspect, int index = -1 ) const;
 
+    static QskSkinHintCacheStatistics hintCacheStatistics();
+    static void resetHintCacheStatistics();
+
   protected:
     virtual void updateNode( QSGNode* );
     virtual bool isTransitionAccepted( QskAspect ) const;
@@ -283,6 +301,8 @@ class QSK_EXPORT QskSkinnable
     QVariant animatedHint( QskAspect, QskSkinHintStatus* ) const;
     QVariant interpolatedHint( QskAspect, QskSkinHintStatus* ) const;
     const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+    const QVariant& resolvedStoredHint( const QskSkin*,
+        QskAspect, QskSkinHintStatus& ) const;
 
     friend class QskSkinStateChanger;
     void replaceSkinStates( QskAspect::States, int sampleIndex = -1 );
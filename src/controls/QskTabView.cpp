@@ -56,6 +56,13 @@ QskTabView::QskTabView( QQuickItem* parent )
     connect( m_data->tabBar, &QskTabBar::currentIndexChanged,
         m_data->stackBox, &QskStackBox::setCurrentIndex );
 
+    connect( m_data->stackBox, &QskStackBox::itemCreated, this,
+        [ this ]( int index, QQuickItem* page )
+        {
+            if ( !isTabEnabled( index ) )
+                page->setEnabled( false );
+        } );
+
     connect( m_data->tabBar, &QskTabBar::currentIndexChanged,
         this, &QskTabView::currentIndexChanged );
 
@@ -125,6 +132,21 @@ int QskTabView::insertTab( int index, const QString& text, QQuickItem* page )
     return index;
 }
 
+int QskTabView::addLazyTab( const QString& text,
+    const std::function< QQuickItem*() >& creator )
+{
+    return insertLazyTab( -1, text, creator );
+}
+
+int QskTabView::insertLazyTab( int index, const QString& text,
+    const std::function< QQuickItem*() >& creator )
+{
+    index = m_data->tabBar->insertTab( index, text );
+    m_data->stackBox->insertLazyItem( index, creator );
+
+    return index;
+}
+
 void QskTabView::removeTab( int index )
 {
     if ( index >= 0 && index < m_data->tabBar->count() )
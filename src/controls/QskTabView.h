@@ -9,6 +9,8 @@
 #include "QskControl.h"
 #include "QskNamespace.h"
 
+#include <functional>
+
 class QskTabBar;
 class QskTabButton;
 
@@ -53,6 +55,15 @@ class QSK_EXPORT QskTabView : public QskControl
     Q_INVOKABLE int addTab( const QString&, QQuickItem* );
     Q_INVOKABLE int insertTab( int index, const QString&, QQuickItem* );
 
+    /*
+        The page is created, when the tab becomes current for the
+        first time - see QskStackBox::addLazyItem(). Before pageAt()
+        returns nullptr.
+     */
+    int addLazyTab( const QString&, const std::function< QQuickItem*() >& );
+    int insertLazyTab( int index, const QString&,
+        const std::function< QQuickItem*() >& );
+
     Q_INVOKABLE void removeTab( int index );
     Q_INVOKABLE void clear( bool autoDelete = false );
 
@@ -8,6 +8,7 @@
 
 #include "QskTextOptions.h"
 #include "QskTextRenderer.h"
+#include "QskPlainTextRenderer.h"
 
 #include <qfontmetrics.h>
 #include <qmath.h>
@@ -145,4 +146,19 @@ QSizeF QskTextLabelSkinlet::sizeHint( const QskSkinnable* skinnable,
     return hint;
 }
 
+void QskTextLabelSkinlet::collectTexts( const QskSkinnable* skinnable,
+    QVector< QskPlainTextRenderer::TextRequest >& requests ) const
+{
+    const auto label = static_cast< const QskTextLabel* >( skinnable );
+
+    const auto text = label->text();
+    if ( text.isEmpty() || label->effectiveTextFormat() != QskTextOptions::PlainText )
+        return;
+
+    auto textOptions = label->textOptions();
+    textOptions.setFormat( QskTextOptions::PlainText );
+
+    requests += { text, label->effectiveFont( QskTextLabel::Text ), textOptions };
+}
+
 #include "moc_QskTextLabelSkinlet.cpp"
@@ -32,6 +32,9 @@ class QSK_EXPORT QskTextLabelSkinlet : public QskSkinlet
     QSizeF sizeHint( const QskSkinnable*,
         Qt::SizeHint, const QSizeF& ) const override;
 
+    void collectTexts( const QskSkinnable*,
+        QVector< QskPlainTextRenderer::TextRequest >& ) const override;
+
   protected:
     QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const override;
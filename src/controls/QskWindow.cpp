@@ -13,6 +13,10 @@
 
 #include <qmath.h>
 #include <qpointer.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
+#include <atomic>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -36,6 +40,7 @@ Q_LOGGING_CATEGORY( logTiming, "qsk.window.timing", QtCriticalMsg )
 
 extern QLocale qskInheritedLocale( const QObject* );
 extern void qskInheritLocale( QObject*, const QLocale& );
+extern void qskAdvanceLayoutProfilerFrame();
 
 static void qskResolveLocale( QskWindow* );
 static bool qskEnforcedSkin = false;
@@ -161,6 +166,9 @@ class QskWindowPrivate : public QQuickWindowPrivate
 
     QskWindow::EventAcceptance eventAcceptance;
 
+    QskPolishStatistics polishStatistics;
+    QskPolishStatistics lastPolishStatistics;
+
     bool explicitLocale : 1;
     bool deleteOnClose : 1;
     bool autoLayoutChildren : 1;
@@ -192,6 +200,19 @@ QskWindow::QskWindow( QWindow* parent )
 
     d_func()->contentItemListener.setEnabled( contentItem(), true );
 
+    connect( this, &QQuickWindow::afterAnimating, this,
+        [ this ]()
+        {
+            // the items have been polished, now starting the next frame
+            Q_D( QskWindow );
+
+            d->lastPolishStatistics = d->polishStatistics;
+            d->polishStatistics = QskPolishStatistics();
+        } );
+
+    connect( this, &QQuickWindow::afterSynchronizing,
+        this, qskAdvanceLayoutProfilerFrame, Qt::DirectConnection );
+
     if ( !qskEnforcedSkin )
         connect( this, &QQuickWindow::afterAnimating, this, &QskWindow::enforceSkin );
 }
@@ -207,6 +228,11 @@ QskWindow::QskWindow( QQuickRenderControl* renderControl, QWindow* parent )
 
 QskWindow::~QskWindow()
 {
+    if ( qskStatisticsWindow == this )
+    {
+        qskStatisticsWindow = nullptr;
+        qskStatisticsCache = nullptr;
+    }
 }
 
 void QskWindow::setScreen( const QString& name )
@@ -287,6 +313,112 @@ void QskWindow::polishItems()
     d->polishItems();
 }
 
+QskPolishStatistics QskWindow::polishStatistics() const
+{
+    return d_func()->lastPolishStatistics;
+}
+
+/*
+    Counting is disabled by default, as size hints are requested
+    very often and we do not want to pay for statistics, that
+    nobody reads.
+ */
+static std::atomic< bool > qskPolishStatisticsEnabled( false );
+
+// the window of the most recent lookup
+static const QQuickWindow* qskStatisticsWindow = nullptr;
+static QskPolishStatistics* qskStatisticsCache = nullptr;
+
+void QskWindow::setPolishStatisticsEnabled( bool on )
+{
+    qskPolishStatisticsEnabled = on;
+}
+
+bool QskWindow::isPolishStatisticsEnabled()
+{
+    return qskPolishStatisticsEnabled;
+}
+
+QskPolishStatistics* qskPolishStatistics( QQuickWindow* window )
+{
+    if ( !qskPolishStatisticsEnabled.load( std::memory_order_relaxed ) )
+        return nullptr;
+
+    if ( window == nullptr )
+        return nullptr;
+
+    if ( window == qskStatisticsWindow )
+        return qskStatisticsCache;
+
+    if ( auto w = qobject_cast< QskWindow* >( window ) )
+    {
+        auto d = static_cast< QskWindowPrivate* >( QQuickWindowPrivate::get( w ) );
+
+        // reset in ~QskWindow
+        qskStatisticsWindow = w;
+        qskStatisticsCache = &d->polishStatistics;
+
+        return qskStatisticsCache;
+    }
+
+    return nullptr;
+}
+
+/*
+    QQuickWindowPrivate::polishItems processes the items in the reverse
+    order of their polish() calls. So a layout might be polished before
+    its parent layout, that resizes it and triggers another polish
+    of the same item in the same frame.
+
+    When running into an item, that has a pending ancestor, we schedule
+    the item again - in front of its pending ancestors, so that it will
+    be processed after them.
+ */
+bool qskDeferPolish( QQuickItem* item )
+{
+    const auto window = item->window();
+    if ( window == nullptr )
+        return false;
+
+    QVarLengthArray< const QQuickItem*, 16 > ancestors;
+
+    for ( auto p = item->parentItem(); p; p = p->parentItem() )
+    {
+        if ( QQuickItemPrivate::get( p )->polishScheduled )
+            ancestors += p;
+    }
+
+    if ( ancestors.isEmpty() )
+        return false;
+
+    auto& itemsToPolish = QQuickWindowPrivate::get( window )->itemsToPolish;
+
+    // the last item will be processed first
+
+    int index = -1;
+
+    for ( int i = 0; i < itemsToPolish.size(); i++ )
+    {
+        if ( std::find( ancestors.cbegin(), ancestors.cend(),
+            itemsToPolish[ i ] ) != ancestors.cend() )
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if ( index < 0 )
+        return false; // should never happen
+
+    itemsToPolish.insert( index, item );
+    QQuickItemPrivate::get( item )->polishScheduled = true;
+
+    if ( auto statistics = qskPolishStatistics( window ) )
+        statistics->deferredPolishes++;
+
+    return true;
+}
+
 bool QskWindow::event( QEvent* event )
 {
     /*
@@ -721,4 +853,25 @@ QskSkin* qskEffectiveSkin( const QQuickWindow* window )
     return qskSkinManager->skin();
 }
 
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskPolishStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "Polish" << '(';
+    debug << "Polishes: " << statistics.polishes;
+    debug << ", Deferred: " << statistics.deferredPolishes;
+    debug << ", Layouts: " << statistics.layouts;
+    debug << ", SizeHints: " << statistics.sizeHints;
+    debug << ')';
+
+    return debug;
+}
+
+#endif
+
 #include "moc_QskWindow.cpp"
@@ -13,6 +13,26 @@ class QskWindowPrivate;
 class QskObjectAttributes;
 class QskSkin;
 
+/*
+    Counters for the work, that has been done for the items
+    of a window in a frame.
+ */
+class QSK_EXPORT QskPolishStatistics
+{
+  public:
+    int polishes = 0; // calls of QskItem::updatePolish
+    int deferredPolishes = 0; // items waiting for a pending ancestor
+    int layouts = 0; // calls of QskControl::updateLayout
+    int sizeHints = 0; // calls of QskControl::effectiveSizeHint
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskPolishStatistics& );
+
+#endif
+
 class QSK_EXPORT QskWindow : public QQuickWindow
 {
     Q_OBJECT
@@ -63,6 +83,15 @@ class QSK_EXPORT QskWindow : public QQuickWindow
 
     void polishItems();
 
+    /*
+        Counters of the most recent frame. Counting is disabled
+        by default and has to be enabled explicitly.
+     */
+    static void setPolishStatisticsEnabled( bool );
+    static bool isPolishStatisticsEnabled();
+
+    QskPolishStatistics polishStatistics() const;
+
     void setCustomRenderMode( const char* mode );
     const char* customRenderMode() const;
 
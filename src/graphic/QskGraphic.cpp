@@ -680,11 +680,13 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
     render( painter, rect, QskColorFilter(), aspectRatioMode );
 }
 
-void QskGraphic::render( QPainter* painter, const QRectF& rect,
-    const QskColorFilter& colorFilter, Qt::AspectRatioMode aspectRatioMode ) const
+QTransform QskGraphic::renderTransform(
+    const QRectF& rect, Qt::AspectRatioMode aspectRatioMode ) const
 {
+    // the transformation, that maps the graphic into rect
+
     if ( isEmpty() || rect.isEmpty() )
-        return;
+        return QTransform();
 
     const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
 
@@ -745,6 +747,18 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
         tr.translate( -boundingBox.x(), -boundingBox.y() );
     }
 
+    return tr;
+}
+
+void QskGraphic::render( QPainter* painter, const QRectF& rect,
+    const QskColorFilter& colorFilter, Qt::AspectRatioMode aspectRatioMode ) const
+{
+    if ( isEmpty() || rect.isEmpty() )
+        return;
+
+    const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
+    const auto tr = renderTransform( rect, aspectRatioMode );
+
     const auto transform = painter->transform();
 
     painter->setTransform( tr, true );
@@ -103,6 +103,9 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
 
     QRectF scaledBoundingRect( qreal sx, qreal sy ) const;
 
+    QTransform renderTransform( const QRectF&,
+        Qt::AspectRatioMode = Qt::IgnoreAspectRatio ) const;
+
     QRectF boundingRect() const;
     QRectF controlPointRect() const;
 
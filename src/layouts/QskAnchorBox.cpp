@@ -3,19 +3,22 @@
  *           SPDX-License-Identifier: BSD-3-Clause
  *****************************************************************************/
 
-#include "AnchorBox.h"
+#include "QskAnchorBox.h"
+#include "QskEvent.h"
+#include "QskQuick.h"
 
 #include "kiwi/Solver.h"
 #include "kiwi/Constraint.h"
 #include "kiwi/Variable.h"
 #include "kiwi/Expression.h"
 
-#include <QskEvent.h>
-#include <QskQuick.h>
+#include <qvector.h>
 
-#include <vector>
+#include <limits>
 #include <map>
 
+using namespace Kiwi;
+
 static inline Qt::Orientation qskOrientation( int edge )
 {
     return ( edge <= Qt::AnchorRight ) ? Qt::Horizontal : Qt::Vertical;
@@ -111,6 +114,7 @@ namespace
 
         QSizeF resolvedSize();
         QSizeF resolvedSize( qreal width, qreal height );
+        QSizeF resolvedSize( Qt::Orientation, qreal value );
 
         void resolve( qreal width, qreal height );
 
@@ -227,6 +231,18 @@ QSizeF LayoutSolver::resolvedSize( qreal width, qreal height )
     return QSizeF( m_width.value(), m_height.value() );
 }
 
+QSizeF LayoutSolver::resolvedSize( Qt::Orientation orientation, qreal value )
+{
+    // only one dimension is suggested, the other one is resolved
+
+    auto& variable = ( orientation == Qt::Horizontal ) ? m_width : m_height;
+
+    addEditVariable( variable, 0.9 * Strength::required );
+    suggestValue( variable, value );
+
+    return resolvedSize();
+}
+
 void LayoutSolver::addSizeConstraints( Geometry& rect, const QSizeF& size,
     RelationalOperator op, double strength )
 {
@@ -243,36 +259,38 @@ void LayoutSolver::addSizeConstraints( Geometry& rect, const QSizeF& size,
     }
 }
 
-class AnchorBox::PrivateData
+class QskAnchorBox::PrivateData
 {
   public:
-    ~PrivateData() { delete solver; }
-
     std::map< QQuickItem*, Geometry > geometries;
-
     QVector< Anchor > anchors;
-    LayoutSolver* solver = nullptr;
+
+    /*
+        The solver for the layout is kept alive until the anchors
+        or the size hints of the children are changing.
+     */
+    std::unique_ptr< LayoutSolver > solver;
 
     QSizeF hints[3];
     bool hasValidHints = false;
 };
 
-AnchorBox::AnchorBox( QQuickItem* parent )
-    : QskControl( parent )
+QskAnchorBox::QskAnchorBox( QQuickItem* parent )
+    : QskBox( false, parent )
     , m_data( new PrivateData )
 {
 }
 
-AnchorBox::~AnchorBox()
+QskAnchorBox::~QskAnchorBox()
 {
 }
 
-void AnchorBox::addAnchors( QQuickItem* item, Qt::Orientations orientations )
+void QskAnchorBox::addAnchors( QQuickItem* item, Qt::Orientations orientations )
 {
     addAnchors( item, this, orientations );
 }
 
-void AnchorBox::addAnchors( QQuickItem* item1,
+void QskAnchorBox::addAnchors( QQuickItem* item1,
     QQuickItem* item2, Qt::Orientations orientations )
 {
     if ( orientations & Qt::Horizontal )
@@ -288,12 +306,12 @@ void AnchorBox::addAnchors( QQuickItem* item1,
     }
 }
 
-void AnchorBox::addAnchors( QQuickItem* item, Qt::Corner corner )
+void QskAnchorBox::addAnchors( QQuickItem* item, Qt::Corner corner )
 {
     addAnchors( item, corner, this, corner );
 }
 
-void AnchorBox::addAnchors( QQuickItem* item1,
+void QskAnchorBox::addAnchors( QQuickItem* item1,
     Qt::Corner corner1, QQuickItem* item2, Qt::Corner corner2 )
 {
     addAnchor( item1, qskAnchorPoint( corner1, Qt::Horizontal ),
@@ -303,20 +321,23 @@ void AnchorBox::addAnchors( QQuickItem* item1,
         item2, qskAnchorPoint( corner2, Qt::Vertical ) );
 }
 
-void AnchorBox::addAnchor( QQuickItem* item,
+void QskAnchorBox::addAnchor( QQuickItem* item,
     Qt::AnchorPoint edge1, Qt::AnchorPoint edge2 )
 {
     addAnchor( item, edge1, this, edge2 );
 }
 
-void AnchorBox::addAnchor( QQuickItem* item1, Qt::AnchorPoint edge1,
+void QskAnchorBox::addAnchor( QQuickItem* item1, Qt::AnchorPoint edge1,
     QQuickItem* item2, Qt::AnchorPoint edge2 )
 {
     if ( item1 == item2 || item1 == nullptr || item2 == nullptr )
         return;
 
     if ( item1 == this )
+    {
         std::swap( item1, item2 );
+        std::swap( edge1, edge2 );
+    }
 
     if ( item2 == this )
         item2 = nullptr;
@@ -347,9 +368,87 @@ void AnchorBox::addAnchor( QQuickItem* item1, Qt::AnchorPoint edge1,
     anchor.edge2 = edge2;
 
     m_data->anchors += anchor;
+
+    invalidate();
 }
 
-void AnchorBox::geometryChangeEvent( QskGeometryChangeEvent* event )
+void QskAnchorBox::removeItem( const QQuickItem* item )
+{
+    if ( item == nullptr || item->parentItem() != this )
+        return;
+
+    removeItemInternal( item );
+
+    if ( item->parentItem() == this )
+        const_cast< QQuickItem* >( item )->setParentItem( nullptr );
+}
+
+void QskAnchorBox::removeItemInternal( const QQuickItem* item )
+{
+    auto it = m_data->geometries.find( const_cast< QQuickItem* >( item ) );
+    if ( it == m_data->geometries.end() )
+        return;
+
+    m_data->geometries.erase( it );
+
+    auto& anchors = m_data->anchors;
+    for ( int i = anchors.count() - 1; i >= 0; i-- )
+    {
+        if ( anchors[ i ].item1 == item || anchors[ i ].item2 == item )
+            anchors.removeAt( i );
+    }
+
+    invalidate();
+}
+
+void QskAnchorBox::clear( bool autoDelete )
+{
+    // taking the items, as unparenting ends up in removeItemInternal
+    const auto geometries = std::move( m_data->geometries );
+
+    m_data->geometries.clear();
+    m_data->anchors.clear();
+
+    for ( auto it = geometries.begin(); it != geometries.end(); ++it )
+    {
+        auto item = it->first;
+
+        if( autoDelete && ( item->parent() == this ) )
+            delete item;
+        else
+            item->setParentItem( nullptr );
+    }
+
+    invalidate();
+}
+
+void QskAnchorBox::invalidate()
+{
+    m_data->solver.reset();
+    m_data->hasValidHints = false;
+
+    resetImplicitSize();
+    polish();
+}
+
+bool QskAnchorBox::event( QEvent* event )
+{
+    if ( event->type() == QEvent::LayoutRequest )
+        invalidate();
+
+    return Inherited::event( event );
+}
+
+void QskAnchorBox::itemChange(
+    QQuickItem::ItemChange change, const QQuickItem::ItemChangeData& value )
+{
+    if ( change == QQuickItem::ItemChildRemovedChange )
+        removeItemInternal( value.item );
+
+    Inherited::itemChange( change, value );
+}
+
+void QskAnchorBox::geometryChangeEvent( QskGeometryChangeEvent* event )
 {
     Inherited::geometryChangeEvent( event );
 
@@ -357,23 +456,69 @@ void AnchorBox::geometryChangeEvent( QskGeometryChangeEvent* event )
         polish();
 }
 
-void AnchorBox::updateLayout()
+void QskAnchorBox::updateLayout()
 {
     if ( !maybeUnresized() )
         updateGeometries( layoutRect() );
 }
 
-QSizeF AnchorBox::layoutSizeHint( Qt::SizeHint which, const QSizeF& constraint ) const
+QSizeF QskAnchorBox::layoutSizeHint( Qt::SizeHint which, const QSizeF& constraint ) const
 {
     if ( constraint.width() >= 0.0 || constraint.height() >= 0.0 )
     {
-        // TODO ...
-        return QSizeF();
+        /*
+            The constraint is suggested for the edit variable of the box,
+            while the children contribute their unconstrained hints.
+            As these results are not cached we always need a new solver.
+         */
+        const qreal max = std::numeric_limits< unsigned int >::max();
+
+        const auto orientation =
+            ( constraint.width() >= 0.0 ) ? Qt::Horizontal : Qt::Vertical;
+
+        const auto value = ( orientation == Qt::Horizontal )
+            ? constraint.width() : constraint.height();
+
+        LayoutSolver solver;
+        solver.setup( false, m_data->anchors, m_data->geometries );
+
+        QSizeF hint;
+
+        switch( which )
+        {
+            case Qt::MinimumSize:
+            {
+                solver.addSizeConstraints();
+                hint = ( orientation == Qt::Horizontal )
+                    ? solver.resolvedSize( value, 0.0 )
+                    : solver.resolvedSize( 0.0, value );
+                break;
+            }
+            case Qt::MaximumSize:
+            {
+                solver.addSizeConstraints();
+                hint = ( orientation == Qt::Horizontal )
+                    ? solver.resolvedSize( value, max )
+                    : solver.resolvedSize( max, value );
+                break;
+            }
+            default:
+            {
+                hint = solver.resolvedSize( orientation, value );
+            }
+        }
+
+        if ( orientation == Qt::Horizontal )
+            hint.setWidth( constraint.width() );
+        else
+            hint.setHeight( constraint.height() );
+
+        return hint;
     }
 
     if ( !m_data->hasValidHints )
     {
-        auto that = const_cast< AnchorBox* >( this );
+        auto that = const_cast< QskAnchorBox* >( this );
 
         that->updateHints();
         m_data->hasValidHints = true;
@@ -382,7 +527,7 @@ QSizeF AnchorBox::layoutSizeHint( Qt::SizeHint which, const QSizeF& constraint )
     return m_data->hints[ which ];
 }
 
-void AnchorBox::updateHints()
+void QskAnchorBox::updateHints()
 {
     /*
          The solver seems to run into overflows with
@@ -401,17 +546,18 @@ void AnchorBox::updateHints()
     m_data->hints[ Qt::MaximumSize ] = solver.resolvedSize( max, max );
 }
 
-void AnchorBox::updateGeometries( const QRectF& rect )
+void QskAnchorBox::updateGeometries( const QRectF& rect )
 {
     auto& solver = m_data->solver;
 
     if ( solver == nullptr )
     {
-        solver = new LayoutSolver();
+        solver.reset( new LayoutSolver() );
         solver->setup( true, m_data->anchors, m_data->geometries );
         solver->addSizeConstraints();
     }
 
+    // only the edit variables for the size of the box are modified
     solver->resolve( rect.width(), rect.height() );
 
     const auto& geometries = m_data->geometries;
@@ -424,4 +570,4 @@ void AnchorBox::updateGeometries( const QRectF& rect )
     }
 }
 
-#include "moc_AnchorBox.cpp"
+#include "moc_QskAnchorBox.cpp"
@@ -3,19 +3,30 @@
  *           SPDX-License-Identifier: BSD-3-Clause
  *****************************************************************************/
 
-#pragma once
+#ifndef QSK_ANCHOR_BOX_H
+#define QSK_ANCHOR_BOX_H
 
-#include "QskControl.h"
+#include "QskBox.h"
 
-class AnchorBox : public QskControl
+/*
+    QskAnchorBox lays out its children according to anchors, that are
+    resolved by a Cassowary constraint solver ( Kiwi ).
+
+    The constraints are built once and the solver is kept alive between
+    layout passes. As long as anchors and size hints of the children
+    do not change, a resize of the box only modifies the edit variables
+    for the size of the box, what is significantly cheaper than
+    setting up the constraints again.
+ */
+class QSK_EXPORT QskAnchorBox : public QskBox
 {
     Q_OBJECT
 
-    using Inherited = QskControl;
+    using Inherited = QskBox;
 
   public:
-    AnchorBox( QQuickItem* parent = nullptr );
-    ~AnchorBox() override;
+    QskAnchorBox( QQuickItem* parent = nullptr );
+    ~QskAnchorBox() override;
 
     // anchoring to the box
     void addAnchor( QQuickItem*, Qt::AnchorPoint, Qt::AnchorPoint );
@@ -28,7 +39,17 @@ class AnchorBox : public QskControl
     void addAnchors( QQuickItem*, QQuickItem*,
         Qt::Orientations = Qt::Horizontal | Qt::Vertical );
 
+    // removing the item and all its anchors
+    void removeItem( const QQuickItem* );
+    void clear( bool autoDelete = false );
+
+  public Q_SLOTS:
+    void invalidate();
+
   protected:
+    bool event( QEvent* ) override;
+    void itemChange( ItemChange, const ItemChangeData& ) override;
+
     void geometryChangeEvent( QskGeometryChangeEvent* ) override;
     void updateLayout() override;
 
@@ -37,7 +58,10 @@ class AnchorBox : public QskControl
   private:
     void updateHints();
     void updateGeometries( const QRectF& );
+    void removeItemInternal( const QQuickItem* );
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
+
+#endif
@@ -39,7 +39,7 @@ class QSK_EXPORT QskGridLayoutEngine : public QskLayoutEngine2D
     bool removeAt( int index );
     bool clear();
 
-    QQuickItem* itemAt( int index ) const;
+    QQuickItem* itemAt( int index ) const override;
     QSizeF spacerAt( int index ) const;
 
     QQuickItem* itemAt( int row, int column ) const;
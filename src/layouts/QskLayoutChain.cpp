@@ -11,6 +11,18 @@
 
 #include <cmath>
 
+static inline qreal qskBoundingMaximum( const QskLayoutChain::CellData& cell )
+{
+    if ( !cell.isValid )
+        return 0.0;
+
+    // cells without stretch, that can't grow, don't exceed their preferred size
+    if ( cell.stretch == 0 && !cell.canGrow )
+        return cell.metrics.preferred();
+
+    return cell.metrics.maximum();
+}
+
 QskLayoutChain::QskLayoutChain()
 {
 }
@@ -172,42 +184,44 @@ void QskLayoutChain::finish()
 
     if ( !m_cells.empty() )
     {
-        const auto maxMaximum = QskLayoutMetrics::unlimited;
-
-        for ( auto& cell : m_cells )
-        {
-            if ( !cell.isValid )
-                continue;
+        /*
+            Instead of stopping at the first unlimited cell the maximum
+            is checked once after the loop. As this avoids branches,
+            that depend on the previous cells, the sums are done
+            in a single tight loop.
+         */
 
-            minimum += cell.metrics.minimum();
-            preferred += cell.metrics.preferred();
+        int sumStretches = 0;
+        int validCells = 0;
 
-            if ( maximum < maxMaximum )
+        for ( const auto& cell : m_cells )
+        {
+            if ( cell.isValid )
             {
-                if ( cell.stretch == 0 && !cell.canGrow )
-                {
-                    maximum += cell.metrics.preferred();
-                }
-                else
-                {
-                    if ( cell.metrics.maximum() == maxMaximum )
-                        maximum = maxMaximum;
-                    else
-                        maximum += cell.metrics.maximum();
-                }
+                minimum += cell.metrics.minimum();
+                preferred += cell.metrics.preferred();
             }
 
-            m_sumStretches += cell.stretch;
-            m_validCells++;
+            maximum += qskBoundingMaximum( cell );
+
+            // invalid cells always have a stretch of 0
+            sumStretches += cell.stretch;
+            validCells += cell.isValid ? 1 : 0;
         }
 
+        m_sumStretches = sumStretches;
+        m_validCells = validCells;
+
         const qreal spacing = ( m_validCells - 1 ) * m_spacing;
 
         minimum += spacing;
         preferred += spacing;
 
-        if ( maximum < maxMaximum )
+        // one unlimited cell is enough to have an unlimited chain
+        if ( maximum < QskLayoutMetrics::unlimited )
             maximum += spacing;
+        else
+            maximum = QskLayoutMetrics::unlimited;
     }
 
     m_boundingMetrics.setMinimum( minimum );
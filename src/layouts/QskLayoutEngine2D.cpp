@@ -7,9 +7,36 @@
 #include "QskLayoutChain.h"
 #include "QskLayoutElement.h"
 #include "QskFunctions.h"
+#include "QskControl.h"
+#include "QskSkinlet.h"
+#include "QskPlainTextRenderer.h"
 
 #include <qguiapplication.h>
 
+static inline bool qskDefaultParallelMeasuring()
+{
+    extern bool qskHasEnvironment( const char* );
+    return qskHasEnvironment( "QSK_PARALLEL_MEASURING" );
+}
+
+static inline void qskCollectTexts( const QQuickItem* item,
+    QVector< QskPlainTextRenderer::TextRequest >& requests )
+{
+    /*
+        Only the item itself: the children are not visited, as nested
+        layouts precompute the texts of their own items. Otherwise each
+        level would collect the complete subtree again.
+     */
+    if ( !item->isVisible() )
+        return;
+
+    if ( auto control = qskControlCast( item ) )
+    {
+        if ( auto skinlet = control->effectiveSkinlet() )
+            skinlet->collectTexts( control, requests );
+    }
+}
+
 namespace
 {
     class LayoutData
@@ -43,6 +70,8 @@ class QskLayoutEngine2D::PrivateData
         , visualDirection( Qt::LeftToRight )
         , constraintType( -1 )
         , blockInvalidate( false )
+        , parallelMeasuring( qskDefaultParallelMeasuring() )
+        , hasPrecomputedHints( false )
     {
     }
 
@@ -87,6 +116,9 @@ class QskLayoutEngine2D::PrivateData
         because of them.
      */
     bool blockInvalidate : 1;
+
+    bool parallelMeasuring : 1;
+    bool hasPrecomputedHints : 1;
 };
 
 QskLayoutEngine2D::QskLayoutEngine2D()
@@ -205,6 +237,21 @@ Qt::Edges QskLayoutEngine2D::extraSpacingAt() const
     return static_cast< Qt::Edges >( m_data->extraSpacingAt );
 }
 
+void QskLayoutEngine2D::setParallelMeasuring( bool on )
+{
+    m_data->parallelMeasuring = on;
+}
+
+bool QskLayoutEngine2D::isParallelMeasuring() const
+{
+    return m_data->parallelMeasuring;
+}
+
+QQuickItem* QskLayoutEngine2D::itemAt( int ) const
+{
+    return nullptr;
+}
+
 void QskLayoutEngine2D::setGeometries( const QRectF& rect )
 {
     if ( rowCount() < 1 || columnCount() < 1 )
@@ -392,6 +439,12 @@ void QskLayoutEngine2D::setupChain( Qt::Orientation orientation,
         return; // already up to date
     }
 
+    if ( m_data->parallelMeasuring && !m_data->hasPrecomputedHints )
+    {
+        m_data->hasPrecomputedHints = true;
+        precomputeHints();
+    }
+
     chain.reset( count, constraint );
     setupChain( orientation, constraints, chain );
     chain.finish();
@@ -404,6 +457,29 @@ void QskLayoutEngine2D::setupChain( Qt::Orientation orientation,
 #endif
 }
 
+void QskLayoutEngine2D::precomputeHints() const
+{
+    /*
+        The size hints of the items are calculated on the GUI thread
+        only, but the expensive part - measuring texts - can be done
+        in advance from a thread pool. The results are stored in
+        the text cache, where the skinlets find them later.
+
+        Only the unconstrained sizes are precomputed. The text sizes
+        for height-for-width requests depend on the widths of the cells
+        and are still measured on the GUI thread.
+     */
+    QVector< QskPlainTextRenderer::TextRequest > requests;
+
+    for ( int i = 0; i < count(); i++ )
+    {
+        if ( const auto item = itemAt( i ) )
+            qskCollectTexts( item, requests );
+    }
+
+    QskPlainTextRenderer::precomputeTextSizes( requests );
+}
+
 void QskLayoutEngine2D::updateSegments( const QSizeF& size ) const
 {
     auto& rowChain = m_data->rowChain;
@@ -460,6 +536,12 @@ void QskLayoutEngine2D::invalidate( int what )
         invalidateElementCache();
     }
 
+    if ( what & HintCache )
+        invalidateHintCache();
+
+    if ( what & ( ElementCache | HintCache ) )
+        m_data->hasPrecomputedHints = false;
+
     if ( what & LayoutCache )
     {
         m_data->rowChain.invalidate();
@@ -471,6 +553,11 @@ void QskLayoutEngine2D::invalidate( int what )
     }
 }
 
+void QskLayoutEngine2D::invalidateHintCache()
+{
+    // engines without cached hints have nothing to do
+}
+
 QskSizePolicy::ConstraintType QskLayoutEngine2D::constraintType() const
 {
     if ( m_data->constraintType < 0 )
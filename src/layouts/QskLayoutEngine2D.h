@@ -14,6 +14,7 @@
 #include <memory>
 
 class QskLayoutElement;
+class QQuickItem;
 
 class QSK_EXPORT QskLayoutEngine2D
 {
@@ -22,6 +23,7 @@ class QSK_EXPORT QskLayoutEngine2D
     virtual ~QskLayoutEngine2D();
 
     virtual int count() const = 0;
+    virtual QQuickItem* itemAt( int index ) const;
 
     int rowCount() const;
     int columnCount() const;
@@ -40,6 +42,16 @@ class QSK_EXPORT QskLayoutEngine2D
 
     qreal defaultSpacing( Qt::Orientation ) const;
 
+    /*
+        In parallel measuring mode the texts of the items are measured
+        from a thread pool, before the size hints are calculated. Children
+        of the items are not included and only unconstrained text sizes
+        are precomputed. The default setting is off and can be changed
+        with the environment variable QSK_PARALLEL_MEASURING.
+     */
+    void setParallelMeasuring( bool );
+    bool isParallelMeasuring() const;
+
     void invalidate();
 
     qreal widthForHeight( qreal height ) const;
@@ -55,7 +67,10 @@ class QSK_EXPORT QskLayoutEngine2D
     enum
     {
         ElementCache = 1 << 0,
-        LayoutCache  = 1 << 1
+        LayoutCache  = 1 << 1,
+
+        // the size hints of the elements
+        HintCache    = 1 << 2
     };
 
     void invalidate( int what );
@@ -64,11 +79,13 @@ class QSK_EXPORT QskLayoutEngine2D
     Q_DISABLE_COPY( QskLayoutEngine2D )
 
     void updateSegments( const QSizeF& ) const;
+    void precomputeHints() const;
 
     virtual void layoutItems() = 0;
     virtual int effectiveCount( Qt::Orientation ) const = 0;
 
     virtual void invalidateElementCache() = 0;
+    virtual void invalidateHintCache();
     QskSizePolicy::ConstraintType constraintType() const;
 
     virtual QskSizePolicy sizePolicyAt( int index ) const = 0;
@@ -85,7 +102,7 @@ class QSK_EXPORT QskLayoutEngine2D
 
 inline void QskLayoutEngine2D::invalidate()
 {
-    invalidate( ElementCache | LayoutCache );
+    invalidate( ElementCache | LayoutCache | HintCache );
 }
 
 inline int QskLayoutEngine2D::rowCount() const
@@ -18,9 +18,9 @@ static void qskSetItemActive( QObject* receiver, const QQuickItem* item, bool on
     if ( on )
     {
         auto sendLayoutRequest =
-            [receiver]()
+            [receiver, item]()
             {
-                QEvent event( QEvent::LayoutRequest );
+                QskLayoutRequestEvent event( item );
                 QCoreApplication::sendEvent( receiver, &event );
             };
 
@@ -248,7 +248,19 @@ bool QskLinearBox::event( QEvent* event )
     {
         case QEvent::LayoutRequest:
         {
-            invalidate();
+            const auto item = qskLayoutRequestItem( event );
+
+            if ( m_data->engine.invalidateItem( item ) )
+            {
+                // only the hints of the sending child have changed
+                resetImplicitSize();
+                polish();
+            }
+            else
+            {
+                invalidate();
+            }
+
             break;
         }
         case QEvent::LayoutDirectionChange:
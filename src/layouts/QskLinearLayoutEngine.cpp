@@ -41,6 +41,9 @@ namespace
         QskLayoutChain::CellData cell(
             Qt::Orientation, bool isLayoutOrientation ) const;
 
+        QskLayoutMetrics metrics( Qt::Orientation, qreal constraint );
+        void invalidateMetrics();
+
       private:
 
         union
@@ -51,6 +54,14 @@ namespace
 
         int m_stretch = -1;
         bool m_isSpacer;
+
+        /*
+            The metrics of the item from the most recent calculation
+            for each orientation. A constraint of -2 indicates, that
+            the metrics need to be recalculated.
+         */
+        QskLayoutMetrics m_metrics[ 2 ];
+        qreal m_constraints[ 2 ] = { -2.0, -2.0 };
     };
 
     class ElementsVector : public std::vector< Element >
@@ -81,6 +92,12 @@ Element::Element( const Element& other )
         m_spacing = other.m_spacing;
     else
         m_item = other.m_item;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        m_metrics[ i ] = other.m_metrics[ i ];
+        m_constraints[ i ] = other.m_constraints[ i ];
+    }
 }
 
 Element& Element::operator=( const Element& other )
@@ -94,6 +111,12 @@ Element& Element::operator=( const Element& other )
 
     m_stretch = other.m_stretch;
 
+    for ( int i = 0; i < 2; i++ )
+    {
+        m_metrics[ i ] = other.m_metrics[ i ];
+        m_constraints[ i ] = other.m_constraints[ i ];
+    }
+
     return *this;
 }
 
@@ -122,6 +145,36 @@ bool Element::isIgnored() const
     return !( m_isSpacer || qskIsVisibleToLayout( m_item ) );
 }
 
+QskLayoutMetrics Element::metrics( Qt::Orientation orientation, qreal constraint )
+{
+    if ( m_isSpacer )
+        return QskLayoutMetrics();
+
+    if ( constraint >= 0.0 )
+    {
+        const auto policy = qskSizePolicy( m_item ).policy( orientation );
+
+        // the constraint has no effect and would only spoil the cache
+        if ( !( policy & QskSizePolicy::ConstrainedFlag ) )
+            constraint = -1.0;
+    }
+
+    const int i = ( orientation == Qt::Horizontal ) ? 0 : 1;
+
+    if ( m_constraints[ i ] != constraint )
+    {
+        m_metrics[ i ] = qskItemMetrics( m_item, orientation, constraint );
+        m_constraints[ i ] = constraint;
+    }
+
+    return m_metrics[ i ];
+}
+
+inline void Element::invalidateMetrics()
+{
+    m_constraints[ 0 ] = m_constraints[ 1 ] = -2.0;
+}
+
 QskLayoutChain::CellData Element::cell(
     Qt::Orientation orientation, bool isLayoutOrientation ) const
 {
@@ -282,7 +335,8 @@ int QskLinearLayoutEngine::insertItem( QQuickItem* item, int index )
         elements.emplace( elements.begin() + index, item );
     }
 
-    invalidate();
+    // the hints of the other elements are still valid
+    invalidate( ElementCache | LayoutCache );
     return index;
 }
 
@@ -339,6 +393,23 @@ bool QskLinearLayoutEngine::clear()
     return true;
 }
 
+bool QskLinearLayoutEngine::invalidateItem( const QQuickItem* item )
+{
+    const auto index = indexOf( item );
+    if ( index < 0 )
+        return false;
+
+    m_data->elements[ index ].invalidateMetrics();
+
+    /*
+        The visibility or the size policy of the item might have
+        changed too, but all other elements keep their hints.
+     */
+    invalidate( ElementCache | LayoutCache );
+
+    return true;
+}
+
 QskSizePolicy QskLinearLayoutEngine::sizePolicyAt( int index ) const
 {
     return qskSizePolicy( itemAt( index ) );
@@ -398,7 +469,8 @@ void QskLinearLayoutEngine::layoutItems()
                 const QskItemLayoutElement layoutElement( item );
 
                 const auto rect = geometryAt( &layoutElement, grid );
-                if ( rect.size().isValid() )
+
+                if ( rect.size().isValid() && rect != qskItemGeometry( item ) )
                     qskSetItemGeometry( item, rect );
             }
         }
@@ -461,6 +533,12 @@ void QskLinearLayoutEngine::invalidateElementCache()
     m_data->sumIgnored = -1;
 }
 
+void QskLinearLayoutEngine::invalidateHintCache()
+{
+    for ( auto& element : m_data->elements )
+        element.invalidateMetrics();
+}
+
 void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
     const QskLayoutChain::Segments& constraints, QskLayoutChain& chain ) const
 {
@@ -471,7 +549,12 @@ void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
 
     qreal constraint = -1.0;
 
-    for ( const auto& element : m_data->elements )
+    /*
+        The metrics of the items are cached, so that rebuilding the chain
+        after a change of a single item does not result in recalculating
+        the hints of all other items.
+     */
+    for ( auto& element : m_data->elements )
     {
         if ( element.isIgnored() )
             continue;
@@ -482,7 +565,7 @@ void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
         auto cell = element.cell( orientation, isLayoutOrientation );
 
         if ( element.item() )
-            cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
+            cell.metrics = element.metrics( orientation, constraint );
 
         chain.expandCell( index2, cell );
 
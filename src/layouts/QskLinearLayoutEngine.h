@@ -39,9 +39,12 @@ class QSK_EXPORT QskLinearLayoutEngine : public QskLayoutEngine2D
     bool removeAt( int index );
     bool clear();
 
+    // invalidates the cached hints of a single item
+    bool invalidateItem( const QQuickItem* );
+
     int indexOf( const QQuickItem* ) const;
 
-    QQuickItem* itemAt( int index ) const;
+    QQuickItem* itemAt( int index ) const override;
     qreal spacerAt( int index ) const;
 
     bool setStretchFactorAt( int index, int stretchFactor );
@@ -57,6 +60,7 @@ class QSK_EXPORT QskLinearLayoutEngine : public QskLayoutEngine2D
     int effectiveCount( Qt::Orientation ) const override;
 
     void invalidateElementCache() override;
+    void invalidateHintCache() override;
 
     virtual void setupChain( Qt::Orientation, const QskLayoutChain::Segments&,
         QskLayoutChain& ) const override final;
@@ -9,15 +9,98 @@
 #include "QskQuick.h"
 
 #include <QPointer>
+#include <qbasictimer.h>
+#include <qcoreevent.h>
+
+namespace
+{
+    class LazyItem
+    {
+      public:
+        QskStackBox::ItemCreator creator;
+        quint64 visit = 0; // for finding the least recently visited items
+        quint64 id = 0; // for finding the slot again
+    };
+}
 
 class QskStackBox::PrivateData
 {
   public:
+    inline bool isLazy( int index ) const
+    {
+        return bool( lazyItems[ index ].creator );
+    }
+
+    int pendingIndex() const
+    {
+        for ( int i = 0; i < items.count(); i++ )
+        {
+            if ( items[ i ] == nullptr && isLazy( i ) )
+                return i;
+        }
+
+        return -1;
+    }
+
+    int createdLazyCount() const
+    {
+        int count = 0;
+
+        for ( int i = 0; i < items.count(); i++ )
+        {
+            if ( items[ i ] && isLazy( i ) )
+                count++;
+        }
+
+        return count;
+    }
+
+    bool canPreload() const
+    {
+        if ( !isLazyPreloading )
+            return false;
+
+        if ( lazyItemLimit >= 0 && createdLazyCount() >= lazyItemLimit )
+            return false;
+
+        return pendingIndex() >= 0;
+    }
+
+    int lazyIndex( quint64 id ) const
+    {
+        for ( int i = 0; i < lazyItems.count(); i++ )
+        {
+            if ( lazyItems[ i ].id == id )
+                return i;
+        }
+
+        return -1;
+    }
+
+    void visit( int index )
+    {
+        if ( index >= 0 )
+            lazyItems[ index ].visit = ++visitCounter;
+    }
+
+    // nullptr for lazy items, that have not been created yet
     QVector< QQuickItem* > items;
+
+    // always in sync with items
+    QVector< LazyItem > lazyItems;
+
     QPointer< QskStackBoxAnimator > animator;
+    QBasicTimer preloadTimer;
+
+    quint64 visitCounter = 0;
+    quint64 idCounter = 0;
 
     int currentIndex = -1;
+    int lazyItemLimit = -1;
+
     Qt::Alignment defaultAlignment = Qt::AlignLeft | Qt::AlignVCenter;
+
+    bool isLazyPreloading = false;
 };
 
 QskStackBox::QskStackBox( QQuickItem* parent )
@@ -142,6 +225,11 @@ void QskStackBox::setCurrentIndex( int index )
     if ( animator )
         animator->stop();
 
+    if ( index >= 0 && m_data->items[ index ] == nullptr )
+        createLazyItem( index );
+
+    m_data->visit( index );
+
     if ( window() && isVisible() && isInitiallyPainted() && animator )
     {
         // start the animation
@@ -165,6 +253,8 @@ void QskStackBox::setCurrentIndex( int index )
     m_data->currentIndex = index;
     polish();
 
+    evictLazyItems();
+
     Q_EMIT currentIndexChanged( m_data->currentIndex );
 }
 
@@ -225,6 +315,7 @@ void QskStackBox::insertItem( int index, QQuickItem* item )
             }
 
             m_data->items.removeAt( oldIndex );
+            m_data->lazyItems.removeAt( oldIndex );
         }
     }
 
@@ -232,17 +323,50 @@ void QskStackBox::insertItem( int index, QQuickItem* item )
         index = itemCount();
 
     m_data->items.insert( index, item );
+    m_data->lazyItems.insert( index, LazyItem() );
 
+    insertItemInternal( index );
+}
+
+void QskStackBox::addLazyItem( const ItemCreator& creator )
+{
+    insertLazyItem( -1, creator );
+}
+
+void QskStackBox::insertLazyItem( int index, const ItemCreator& creator )
+{
+    if ( !creator )
+        return;
+
+    if ( ( index < 0 ) || ( index >= itemCount() ) )
+        index = itemCount();
+
+    m_data->items.insert( index, nullptr );
+    m_data->lazyItems.insert( index, LazyItem { creator, 0, ++m_data->idCounter } );
+
+    insertItemInternal( index );
+}
+
+void QskStackBox::insertItemInternal( int index )
+{
     const int oldCurrentIndex = m_data->currentIndex;
 
     if ( m_data->items.count() == 1 )
     {
         m_data->currentIndex = 0;
-        item->setVisible( true );
+        m_data->visit( 0 );
+
+        auto item = m_data->items[ 0 ];
+        if ( item == nullptr )
+            item = createLazyItem( 0 );
+
+        if ( item )
+            item->setVisible( true );
     }
     else
     {
-        item->setVisible( false );
+        if ( auto item = m_data->items[ index ] )
+            item->setVisible( false );
 
         if ( index <= m_data->currentIndex )
             m_data->currentIndex++;
@@ -253,6 +377,172 @@ void QskStackBox::insertItem( int index, QQuickItem* item )
 
     resetImplicitSize();
     polish();
+
+    updatePreloading();
+}
+
+bool QskStackBox::isItemCreated( int index ) const
+{
+    return m_data->items.value( index ) != nullptr;
+}
+
+QQuickItem* QskStackBox::createLazyItem( int index )
+{
+    const auto lazyItem = m_data->lazyItems[ index ];
+    if ( !lazyItem.creator )
+        return nullptr;
+
+    auto item = lazyItem.creator();
+    if ( item == nullptr )
+        return nullptr;
+
+    /*
+        The creator might have modified the box, so we have
+        to find the slot of the placeholder again
+     */
+    index = m_data->lazyIndex( lazyItem.id );
+
+    if ( index < 0 || m_data->items[ index ] )
+    {
+        // removed or already created in the meantime
+        if ( item->parent() == nullptr )
+            delete item;
+
+        return index < 0 ? nullptr : m_data->items[ index ];
+    }
+
+    reparentItem( item );
+
+    if ( !qskPlacementPolicy( item ).isEffective() )
+        qskSetPlacementPolicy( item, QskPlacementPolicy() );
+
+    item->setVisible( false );
+    m_data->items[ index ] = item;
+
+    resetImplicitSize();
+    polish();
+
+    Q_EMIT itemCreated( index, item );
+
+    return item;
+}
+
+void QskStackBox::evictLazyItems()
+{
+    const auto limit = m_data->lazyItemLimit;
+    if ( limit < 0 )
+        return;
+
+    // the items of a running transition are not evicted
+    int startIndex = -1;
+    int endIndex = -1;
+
+    if ( auto animator = m_data->animator.data() )
+    {
+        if ( animator->isRunning() )
+        {
+            startIndex = animator->startIndex();
+            endIndex = animator->endIndex();
+        }
+    }
+
+    auto& items = m_data->items;
+    bool isModified = false;
+
+    while ( m_data->createdLazyCount() > limit )
+    {
+        int index = -1;
+
+        for ( int i = 0; i < items.count(); i++ )
+        {
+            if ( items[ i ] == nullptr || !m_data->isLazy( i ) )
+                continue;
+
+            if ( i == m_data->currentIndex || i == startIndex || i == endIndex )
+                continue;
+
+            if ( index < 0 || m_data->lazyItems[ i ].visit < m_data->lazyItems[ index ].visit )
+                index = i;
+        }
+
+        if ( index < 0 )
+            break;
+
+        auto item = items[ index ];
+        items[ index ] = nullptr;
+
+        delete item;
+        isModified = true;
+    }
+
+    if ( isModified )
+    {
+        resetImplicitSize();
+        polish();
+    }
+}
+
+void QskStackBox::setLazyPreloading( bool on )
+{
+    if ( on != m_data->isLazyPreloading )
+    {
+        m_data->isLazyPreloading = on;
+        updatePreloading();
+    }
+}
+
+bool QskStackBox::hasLazyPreloading() const
+{
+    return m_data->isLazyPreloading;
+}
+
+void QskStackBox::setLazyItemLimit( int limit )
+{
+    limit = qMax( limit, -1 );
+
+    if ( limit != m_data->lazyItemLimit )
+    {
+        m_data->lazyItemLimit = limit;
+
+        evictLazyItems();
+        updatePreloading();
+    }
+}
+
+int QskStackBox::lazyItemLimit() const
+{
+    return m_data->lazyItemLimit;
+}
+
+void QskStackBox::updatePreloading()
+{
+    auto& timer = m_data->preloadTimer;
+
+    if ( m_data->canPreload() )
+    {
+        // a zero timer fires, when there are no other events to process
+        if ( !timer.isActive() )
+            timer.start( 0, this );
+    }
+    else
+    {
+        timer.stop();
+    }
+}
+
+void QskStackBox::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->preloadTimer.timerId() )
+    {
+        const auto index = m_data->pendingIndex();
+        if ( index >= 0 )
+            createLazyItem( index );
+
+        updatePreloading();
+        return;
+    }
+
+    Inherited::timerEvent( event );
 }
 
 void QskStackBox::insertItem(
@@ -274,13 +564,20 @@ void QskStackBox::removeItemInternal( int index, bool unparent )
     if ( index < 0 || index >= m_data->items.count() )
         return;
 
-    if ( unparent )
-    {
-        if ( auto item = m_data->items[ index ] )
-            unparentItem( item );
-    }
+    auto item = m_data->items[ index ];
+    const bool isLazy = m_data->isLazy( index );
+
+    if ( unparent && item )
+        unparentItem( item );
 
     m_data->items.removeAt( index );
+    m_data->lazyItems.removeAt( index );
+
+    if ( unparent && isLazy )
+    {
+        // lazy items are owned by the box
+        delete item;
+    }
 
     auto& currentIndex = m_data->currentIndex;
 
@@ -292,13 +589,22 @@ void QskStackBox::removeItemInternal( int index, bool unparent )
             currentIndex = 0;
 
         if ( currentIndex >= 0 )
-            m_data->items[ currentIndex ]->setVisible( true );
+        {
+            auto currentItem = m_data->items[ currentIndex ];
+            if ( currentItem == nullptr )
+                currentItem = createLazyItem( currentIndex );
+
+            if ( currentItem )
+                currentItem->setVisible( true );
+        }
 
         Q_EMIT currentIndexChanged( currentIndex );
     }
 
     resetImplicitSize();
     polish();
+
+    updatePreloading();
 }
 
 void QskStackBox::removeItem( const QQuickItem* item )
@@ -318,16 +624,29 @@ void QskStackBox::autoRemoveItem( QQuickItem* item )
 
 void QskStackBox::clear( bool autoDelete )
 {
-    for ( const auto item : std::as_const( m_data->items ) )
+    // taking the items, as deleting/unparenting ends up in autoRemoveItem
+    const auto items = std::move( m_data->items );
+    const auto lazyItems = std::move( m_data->lazyItems );
+
+    m_data->items.clear();
+    m_data->lazyItems.clear();
+
+    m_data->preloadTimer.stop();
+
+    for ( int i = 0; i < items.count(); i++ )
     {
-        if( autoDelete && ( item->parent() == this ) )
+        auto item = items[ i ];
+        if ( item == nullptr )
+            continue;
+
+        const bool doDelete = autoDelete || bool( lazyItems[ i ].creator );
+
+        if( doDelete && ( item->parent() == this ) )
             delete item;
         else
             item->setParentItem( nullptr );
     }
 
-    m_data->items.clear();
-
     if ( m_data->currentIndex >= 0 )
     {
         m_data->currentIndex = -1;
@@ -359,6 +678,8 @@ void QskStackBox::updateLayout()
     for ( int i = 0; i < m_data->items.count(); i++ )
     {
         auto item = m_data->items[ i ];
+        if ( item == nullptr )
+            continue;
 
         const auto visibility =
             ( i == m_data->currentIndex ) ? Qsk::Visible : Qsk::Hidden;
@@ -382,6 +703,9 @@ QSizeF QskStackBox::layoutSizeHint(
 
     for ( const auto item : std::as_const( m_data->items ) )
     {
+        if ( item == nullptr )
+            continue; // a lazy item, that has not been created yet
+
         /*
             We ignore the retainSizeWhenVisible flag and include all
             invisible items. Maybe we should offer a flag to control this ?
@@ -450,6 +774,12 @@ void QskStackBox::dump() const
 
         debug << "  " << i << ": ";
 
+        if ( item == nullptr )
+        {
+            debug << "(lazy)" << '\n';
+            continue;
+        }
+
         const auto size = qskSizeConstraint( item, Qt::PreferredSize );
         debug << item->metaObject()->className()
               << " w:" << size.width() << " h:" << size.height();
@@ -7,6 +7,7 @@
 #define QSK_STACK_BOX_H
 
 #include "QskIndexedLayoutBox.h"
+#include <functional>
 
 class QskStackBoxAnimator;
 
@@ -26,6 +27,8 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     using Inherited = QskBox;
 
   public:
+    using ItemCreator = std::function< QQuickItem*() >;
+
     explicit QskStackBox( QQuickItem* parent = nullptr );
     QskStackBox( bool autoAddChildren, QQuickItem* parent = nullptr );
 
@@ -43,6 +46,36 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void insertItem( int index, QQuickItem* );
     void insertItem( int index, QQuickItem*, Qt::Alignment );
 
+    /*
+        Lazy items are created by the creator, when becoming the current
+        item - or the end of a transition - for the first time. Before
+        itemAtIndex() returns nullptr and the item does not contribute
+        to the size hints of the box.
+
+        Lazy items are owned by the box and might be deleted, when
+        exceeding the lazyItemLimit(). Then they will be created again,
+        when being needed.
+     */
+    void addLazyItem( const ItemCreator& );
+    void insertLazyItem( int index, const ItemCreator& );
+
+    bool isItemCreated( int index ) const;
+
+    /*
+        When enabled, lazy items that have not been created yet,
+        are created one by one, when the event loop is idle.
+     */
+    void setLazyPreloading( bool );
+    bool hasLazyPreloading() const;
+
+    /*
+        The maximum number of created lazy items. When being exceeded
+        the least recently visited ones are deleted. A negative value
+        means unlimited, what is the default setting.
+     */
+    void setLazyItemLimit( int );
+    int lazyItemLimit() const;
+
     void removeItem( const QQuickItem* );
     void removeAt( int index );
 
@@ -74,9 +107,11 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void currentIndexChanged( int index );
     void transientIndexChanged( qreal index );
     void currentItemChanged( QQuickItem* );
+    void itemCreated( int index, QQuickItem* );
 
   protected:
     bool event( QEvent* ) override;
+    void timerEvent( QTimerEvent* ) override;
     void updateLayout() override;
 
     QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
@@ -88,6 +123,11 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void autoRemoveItem( QQuickItem* ) override final;
 
     void removeItemInternal( int index, bool unparent );
+    void insertItemInternal( int index );
+
+    QQuickItem* createLazyItem( int index );
+    void evictLazyItems();
+    void updatePreloading();
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -1,6 +1,8 @@
 #include "Expression.h"
 #include "Term.h"
 
+namespace Kiwi
+{
 Expression::Expression( double constant )
     : m_constant( constant )
 {
@@ -224,3 +226,4 @@ Expression operator-( double constant, const Variable& variable )
 {
     return -variable + constant;
 }
+}
@@ -3,6 +3,8 @@
 #include <vector>
 #include "Term.h"
 
+namespace Kiwi
+{
 class Expression
 {
   public:
@@ -65,4 +67,4 @@ extern Expression operator+( const Variable&, double );
 extern Expression operator-( const Variable&, double );
 extern Expression operator+( double, const Variable& );
 extern Expression operator-( double, const Variable& );
-
+}
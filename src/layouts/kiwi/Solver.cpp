@@ -9,6 +9,8 @@
 #include <vector>
 #include <cstdint>
 
+namespace Kiwi
+{
 template< typename T >
 class FlatMap
 {
@@ -1081,3 +1083,4 @@ void Solver::reset()
 {
     m_solver->reset();
 }
+}
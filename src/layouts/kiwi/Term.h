@@ -3,6 +3,8 @@
 #include <utility>
 #include "Variable.h"
 
+namespace Kiwi
+{
 class Term
 {
   public:
@@ -79,3 +81,4 @@ inline Term operator*( double coefficient, const Variable& variable )
 {
     return variable * coefficient;
 }
+}
@@ -2,6 +2,8 @@
 
 #include <memory>
 
+namespace Kiwi
+{
 class Variable
 {
   public:
@@ -44,3 +46,4 @@ class Variable
         return lhs.m_value < rhs.m_value;
     }
 };
+}
@@ -0,0 +1,475 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxDistanceFieldNode.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxMetrics.h"
+#include "QskBoxRenderer.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+
+#include <qcolor.h>
+#include <qsgmaterialshader.h>
+#include <qsgmaterial.h>
+#include <qvector2d.h>
+#include <qvector4d.h>
+
+#include <atomic>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using RhiShader = QSGMaterialRhiShader;
+#else
+    using RhiShader = QSGMaterialShader;
+#endif
+
+static std::atomic< bool >& qskPreferDistanceField()
+{
+    extern bool qskHasEnvironment( const char* );
+
+    static std::atomic< bool > on( qskHasEnvironment( "QSK_BOX_DISTANCE_FIELD" ) );
+    return on;
+}
+
+static inline QVector4D qskPremultiplied( const QColor& color )
+{
+    const auto a = color.alphaF();
+    return QVector4D( color.redF() * a, color.greenF() * a, color.blueF() * a, a );
+}
+
+static inline bool qskIsCircular( qreal rx, qreal ry )
+{
+    return qFuzzyCompare( rx + 1.0, ry + 1.0 );
+}
+
+static inline bool qskIsGradientSupported( const QskGradient& gradient )
+{
+    if ( !gradient.isVisible() || gradient.isMonochrome() )
+        return true;
+
+    if ( gradient.type() != QskGradient::Linear
+        || gradient.stretchMode() != QskGradient::StretchToSize
+        || gradient.spreadMode() != QskGradient::PadSpread )
+    {
+        return false;
+    }
+
+    const auto& stops = gradient.stops();
+
+    return ( stops.size() == 2 )
+        && ( stops[ 0 ].position() == 0.0 ) && ( stops[ 1 ].position() == 1.0 );
+}
+
+namespace
+{
+    // the layout of the uniform buffer behind the matrix: see boxdistancefield.frag
+
+    class Uniforms
+    {
+      public:
+        QVector4D outerRadii;
+        QVector4D innerRadii;
+        QVector4D innerRect;
+        QVector4D fillStartColor;
+        QVector4D fillStopColor;
+        QVector4D borderColor;
+        QVector4D gradient;
+        QVector2D halfSize;
+    };
+
+    class Material final : public QSGMaterial
+    {
+      public:
+        Material();
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+        QSGMaterialType* type() const override;
+
+        int compare( const QSGMaterial* other ) const override;
+
+        bool setUniforms( const Uniforms& );
+
+        Uniforms m_uniforms;
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderFileName( VertexStage, root + "boxdistancefield.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "boxdistancefield.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+        {
+            const auto matOld = static_cast< Material* >( oldMaterial );
+            const auto matNew = static_cast< Material* >( newMaterial );
+
+            Q_ASSERT( state.uniformData()->size() >= 188 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->compare( matOld ) != 0 )
+            {
+                memcpy( data + 64, &matNew->m_uniforms, sizeof( Uniforms ) );
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 184, &opacity, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "boxdistancefield.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "boxdistancefield.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            auto p = program();
+
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_opacityId = p->uniformLocation( "opacity" );
+            m_halfSizeId = p->uniformLocation( "halfSize" );
+            m_outerRadiiId = p->uniformLocation( "outerRadii" );
+            m_innerRadiiId = p->uniformLocation( "innerRadii" );
+            m_innerRectId = p->uniformLocation( "innerRect" );
+            m_fillStartColorId = p->uniformLocation( "fillStartColor" );
+            m_fillStopColorId = p->uniformLocation( "fillStopColor" );
+            m_borderColorId = p->uniformLocation( "borderColor" );
+            m_gradientId = p->uniformLocation( "gradient" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+        {
+            auto p = program();
+
+            if ( state.isMatrixDirty() )
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+            if ( state.isOpacityDirty() )
+                p->setUniformValue( m_opacityId, state.opacity() );
+
+            bool updateMaterial = ( oldMaterial == nullptr )
+                || newMaterial->compare( oldMaterial ) != 0;
+
+            updateMaterial |= state.isCachedMaterialDataDirty();
+
+            if ( updateMaterial )
+            {
+                const auto& u = static_cast< const Material* >( newMaterial )->m_uniforms;
+
+                p->setUniformValue( m_halfSizeId, u.halfSize );
+                p->setUniformValue( m_outerRadiiId, u.outerRadii );
+                p->setUniformValue( m_innerRadiiId, u.innerRadii );
+                p->setUniformValue( m_innerRectId, u.innerRect );
+                p->setUniformValue( m_fillStartColorId, u.fillStartColor );
+                p->setUniformValue( m_fillStopColorId, u.fillStopColor );
+                p->setUniformValue( m_borderColorId, u.borderColor );
+                p->setUniformValue( m_gradientId, u.gradient );
+            }
+        }
+
+      private:
+        int m_matrixId = -1;
+        int m_opacityId = -1;
+        int m_halfSizeId = -1;
+        int m_outerRadiiId = -1;
+        int m_innerRadiiId = -1;
+        int m_innerRectId = -1;
+        int m_fillStartColorId = -1;
+        int m_fillStopColorId = -1;
+        int m_borderColorId = -1;
+        int m_gradientId = -1;
+    };
+}
+
+#endif
+
+Material::Material()
+{
+    setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+QSGMaterialType* Material::type() const
+{
+    static QSGMaterialType staticType;
+    return &staticType;
+}
+
+int Material::compare( const QSGMaterial* other ) const
+{
+    auto material = static_cast< const Material* >( other );
+
+    if ( memcmp( &material->m_uniforms, &m_uniforms, sizeof( Uniforms ) ) == 0 )
+        return 0;
+
+    return QSGMaterial::compare( other );
+}
+
+bool Material::setUniforms( const Uniforms& uniforms )
+{
+    if ( memcmp( &uniforms, &m_uniforms, sizeof( Uniforms ) ) == 0 )
+        return false;
+
+    m_uniforms = uniforms;
+    return true;
+}
+
+class QskBoxDistanceFieldNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskBoxDistanceFieldNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+    {
+    }
+
+    QSGGeometry geometry;
+    Material material;
+
+    QRectF rect;
+};
+
+QskBoxDistanceFieldNode::QskBoxDistanceFieldNode()
+    : QSGGeometryNode( *new QskBoxDistanceFieldNodePrivate )
+{
+    Q_D( QskBoxDistanceFieldNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+}
+
+QskBoxDistanceFieldNode::~QskBoxDistanceFieldNode()
+{
+}
+
+void QskBoxDistanceFieldNode::updateBox( const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    Q_D( QskBoxDistanceFieldNode );
+
+    const qreal hw = 0.5 * rect.width();
+    const qreal hh = 0.5 * rect.height();
+
+    if ( rect != d->rect )
+    {
+        d->rect = rect;
+
+        /*
+            The quad exceeds the box by a pixel, so that the antialiasing
+            at the edges does not get clipped. The texture coordinates
+            are the positions relative to the center of the box.
+         */
+        const qreal m = 1.0;
+
+        QSGGeometry::updateTexturedRectGeometry( &d->geometry,
+            rect.adjusted( -m, -m, m, m ),
+            QRectF( -hw - m, -hh - m, 2 * ( hw + m ), 2 * ( hh + m ) ) );
+
+        d->geometry.markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+
+    const auto shape = shapeMetrics.toAbsolute( rect.size() );
+    const auto border = borderMetrics.toAbsolute( rect.size() );
+
+    const QskBoxMetrics metrics( rect, shape, border );
+    const auto& c = metrics.corners;
+
+    Uniforms uniforms;
+
+    uniforms.halfSize = QVector2D( hw, hh );
+
+    if ( metrics.isOutsideRounded )
+    {
+        uniforms.outerRadii = QVector4D(
+            c[ Qt::TopLeftCorner ].radiusX, c[ Qt::TopRightCorner ].radiusX,
+            c[ Qt::BottomLeftCorner ].radiusX, c[ Qt::BottomRightCorner ].radiusX );
+    }
+
+    const bool hasBorder = metrics.hasBorder && borderColors.isVisible();
+
+    if ( hasBorder )
+    {
+        const auto& r = metrics.innerRect;
+        const auto center = r.center() - rect.center();
+
+        uniforms.innerRect = QVector4D( center.x(), center.y(),
+            0.5 * r.width(), 0.5 * r.height() );
+
+        if ( metrics.isOutsideRounded )
+        {
+            uniforms.innerRadii = QVector4D(
+                c[ Qt::TopLeftCorner ].radiusInnerX, c[ Qt::TopRightCorner ].radiusInnerX,
+                c[ Qt::BottomLeftCorner ].radiusInnerX, c[ Qt::BottomRightCorner ].radiusInnerX );
+        }
+
+        uniforms.borderColor = qskPremultiplied( borderColors.left().startColor() );
+    }
+    else
+    {
+        uniforms.innerRect = QVector4D( 0.0, 0.0, hw, hh );
+        uniforms.innerRadii = uniforms.outerRadii;
+    }
+
+    if ( gradient.isVisible() )
+    {
+        const auto fillGradient = QskBoxRenderer::effectiveGradient( gradient );
+
+        uniforms.fillStartColor = qskPremultiplied( fillGradient.startColor() );
+        uniforms.fillStopColor = qskPremultiplied( fillGradient.endColor() );
+
+        if ( !fillGradient.isMonochrome() )
+        {
+            /*
+                Like in QskBoxRenderer the gradient is stretched to the
+                inner rectangle, but the shader expects the gradient
+                vector relative to the center of the box.
+             */
+            const auto& fillRect = metrics.innerRect.isEmpty() ? rect : metrics.innerRect;
+            const auto dir = fillGradient.stretchedTo( fillRect ).linearDirection();
+
+            const qreal x1 = dir.x1() - rect.center().x();
+            const qreal y1 = dir.y1() - rect.center().y();
+            const qreal dx = dir.x2() - dir.x1();
+            const qreal dy = dir.y2() - dir.y1();
+
+            const qreal l2 = dx * dx + dy * dy;
+            if ( l2 > 0.0 )
+                uniforms.gradient = QVector4D( x1, y1, dx / l2, dy / l2 );
+        }
+    }
+
+    if ( d->material.setUniforms( uniforms ) )
+        markDirty( QSGNode::DirtyMaterial );
+}
+
+bool QskBoxDistanceFieldNode::isSupported( const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    if ( rect.isEmpty() )
+        return false;
+
+    if ( !qskIsGradientSupported( QskBoxRenderer::effectiveGradient( gradient ) ) )
+        return false;
+
+    const auto shape = shapeMetrics.toAbsolute( rect.size() );
+    const auto border = borderMetrics.toAbsolute( rect.size() );
+
+    const QskBoxMetrics metrics( rect, shape, border );
+
+    const bool hasBorder = metrics.hasBorder && borderColors.isVisible();
+
+    if ( hasBorder && !borderColors.isMonochrome() )
+        return false;
+
+    if ( metrics.isOutsideRounded )
+    {
+        for ( const auto& c : metrics.corners )
+        {
+            if ( !qskIsCircular( c.radiusX, c.radiusY ) )
+                return false;
+
+            if ( hasBorder && !qskIsCircular( c.radiusInnerX, c.radiusInnerY ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void QskBoxDistanceFieldNode::setPreferred( bool on )
+{
+    qskPreferDistanceField() = on;
+}
+
+bool QskBoxDistanceFieldNode::isPreferred()
+{
+    return qskPreferDistanceField();
+}
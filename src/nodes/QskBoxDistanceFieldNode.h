@@ -0,0 +1,58 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOX_DISTANCE_FIELD_NODE_H
+#define QSK_BOX_DISTANCE_FIELD_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+
+class QskBoxDistanceFieldNodePrivate;
+
+/*
+    QskBoxDistanceFieldNode renders a rounded box from a single quad,
+    where a fragment shader calculates the signed distances to the
+    outer and inner contours. The number of vertices does not depend
+    on the radii and changes of the metrics only modify uniforms.
+
+    Boxes with elliptic corners, irregular borders or gradients
+    other than a linear gradient between 2 colors are not supported and
+    have to be rendered by QskBoxRectangleNode: see isSupported().
+
+    As each box has its own material, the renderer is not able to
+    batch these nodes.
+ */
+class QSK_EXPORT QskBoxDistanceFieldNode : public QSGGeometryNode
+{
+  public:
+    QskBoxDistanceFieldNode();
+    ~QskBoxDistanceFieldNode() override;
+
+    void updateBox( const QRectF&,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+    static bool isSupported( const QRectF&,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+    /*
+        Indicates if QskBoxNode prefers the distance field for
+        supported boxes. The default setting is false and can be
+        changed by setting the environment variable QSK_BOX_DISTANCE_FIELD.
+     */
+    static void setPreferred( bool );
+    static bool isPreferred();
+
+  private:
+    Q_DECLARE_PRIVATE( QskBoxDistanceFieldNode )
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "QskBoxNode.h"
 #include "QskBoxShadowNode.h"
 #include "QskBoxRectangleNode.h"
+#include "QskBoxDistanceFieldNode.h"
 #include "QskSGNode.h"
 
 #include "QskGradient.h"
@@ -20,6 +21,7 @@ namespace
     enum Role
     {
         ShadowRole,
+        DistanceFieldRole,
         BoxRole,
         FillRole
     };
@@ -27,7 +29,8 @@ namespace
 
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
-    static const QVector< quint8 > roles = { ShadowRole, BoxRole, FillRole };
+    static const QVector< quint8 > roles =
+        { ShadowRole, DistanceFieldRole, BoxRole, FillRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -65,6 +68,7 @@ void QskBoxNode::updateNode( const QRectF& rect,
     using namespace QskSGNode;
 
     QskBoxShadowNode* shadowNode = nullptr;
+    QskBoxDistanceFieldNode* distanceFieldNode = nullptr;
     QskBoxRectangleNode* rectNode = nullptr;
     QskBoxRectangleNode* fillNode = nullptr;
 
@@ -83,7 +87,18 @@ void QskBoxNode::updateNode( const QRectF& rect,
                 shape, shadowMetrics.blurRadius(), shadowColor );
         }
 
-        if ( hasBorder || hasFilling )
+        const bool useDistanceField = ( hasBorder || hasFilling )
+            && QskBoxDistanceFieldNode::isPreferred()
+            && QskBoxDistanceFieldNode::isSupported(
+                rect, shape, borderMetrics, borderColors, gradient );
+
+        if ( useDistanceField )
+        {
+            distanceFieldNode = qskNode< QskBoxDistanceFieldNode >( this, DistanceFieldRole );
+            distanceFieldNode->updateBox(
+                rect, shape, borderMetrics, borderColors, gradient );
+        }
+        else if ( hasBorder || hasFilling )
         {
             rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
 
@@ -109,6 +124,7 @@ void QskBoxNode::updateNode( const QRectF& rect,
     }
 
     qskUpdateChildren( this, ShadowRole, shadowNode );
+    qskUpdateChildren( this, DistanceFieldRole, distanceFieldNode );
     qskUpdateChildren( this, BoxRole, rectNode );
     qskUpdateChildren( this, FillRole, fillNode );
 }
@@ -12,6 +12,160 @@
 #include "QskGradientDirection.h"
 #include "QskFillNodePrivate.h"
 
+#include <qatomic.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+static QAtomicInt qskGeometryRebuilds;
+static QAtomicInt qskGeometryTranslations;
+static QAtomicInt qskGeometryShares;
+
+namespace
+{
+    /*
+        The complete parameters of the tessellation. Comparing them - instead
+        of relying on a hash value only - avoids, that a hash collision
+        results in sharing the vertices of a different box.
+     */
+    class GeometryKey
+    {
+      public:
+        inline bool operator==( const GeometryKey& other ) const noexcept
+        {
+            return ( size.width() == other.size.width() )
+                && ( size.height() == other.size.height() )
+                && ( position.x() == other.position.x() )
+                && ( position.y() == other.position.y() )
+                && ( content == other.content )
+                && ( isColored == other.isColored )
+                && ( colorsHash == other.colorsHash )
+                && ( shape == other.shape )
+                && ( borderMetrics == other.borderMetrics )
+                && ( borderColors == other.borderColors )
+                && ( gradient == other.gradient );
+        }
+
+        inline QskHashValue hash( QskHashValue seed ) const noexcept
+        {
+            auto hash = qHashBits( &size, sizeof( size ), seed );
+            hash = qHashBits( &position, sizeof( position ), hash );
+            hash = shape.hash( hash );
+            hash = borderMetrics.hash( hash );
+            hash = ::qHash( content, hash );
+
+            return isColored ? ::qHash( colorsHash, hash ) : hash;
+        }
+
+        QSizeF size;
+        QPointF position;
+
+        // absolute metrics
+        QskBoxShapeMetrics shape;
+        QskBoxBorderMetrics borderMetrics;
+
+        int content = -1;
+
+        /*
+            For colored geometries: the hash is used for finding the bucket,
+            while the colors are compared. The colors of uncolored
+            geometries are ignored.
+         */
+        bool isColored = false;
+        QskHashValue colorsHash = 0;
+
+        QskBoxBorderColors borderColors;
+        QskGradient gradient;
+    };
+
+    inline QskHashValue qHash( const GeometryKey& key, QskHashValue seed = 0 ) noexcept
+    {
+        return key.hash( seed );
+    }
+
+    /*
+        Boxes with the same size, shape, border metrics and position
+        in item coordinates - f.e the buttons of a virtual keyboard - end up
+        in the same vertices. So we share them between the nodes instead
+        of tessellating and storing them for each node.
+
+        As the scene graph might run in more than one thread ( one for each window )
+        the cache is protected by a mutex.
+     */
+    class GeometryCache
+    {
+      public:
+        ~GeometryCache()
+        {
+            for ( const auto& entry : std::as_const( m_entries ) )
+                delete entry.geometry;
+        }
+
+        QSGGeometry* acquire( const GeometryKey& key )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_entries.find( key );
+            if ( it == m_entries.end() )
+                return nullptr;
+
+            it->refCount++;
+            return it->geometry;
+        }
+
+        QSGGeometry* insert( const GeometryKey& key, QSGGeometry* geometry )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_entries.find( key );
+            if ( it != m_entries.end() )
+            {
+                // has been inserted from another scene graph thread meanwhile
+                delete geometry;
+
+                it->refCount++;
+                return it->geometry;
+            }
+
+            m_entries.insert( key, { geometry, 1 } );
+            return geometry;
+        }
+
+        void release( const GeometryKey& key )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_entries.find( key );
+            if ( it != m_entries.end() && --it->refCount == 0 )
+            {
+                delete it->geometry;
+                m_entries.erase( it );
+            }
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            QSGGeometry* geometry;
+            int refCount;
+        };
+
+        QMutex m_mutex;
+        QHash< GeometryKey, Entry > m_entries;
+    };
+}
+
+Q_GLOBAL_STATIC( GeometryCache, qskGeometryCache )
+
+static inline bool qskIsGeometrySharingEnabled()
+{
+    extern bool qskHasEnvironment( const char* );
+
+    static const bool on = !qskHasEnvironment( "QSK_NO_SHARED_BOX_GEOMETRY" );
+    return on;
+}
+
 static inline bool qskHasBorder( 
     const QskBoxBorderMetrics& metrics, const QskBoxBorderColors& colors )
 {
@@ -21,39 +175,254 @@ static inline bool qskHasBorder(
 class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
 {
   public:
+    enum Content
+    {
+        Filling,
+        Border,
+        BorderAndFilling
+    };
+
+    ~QskBoxRectangleNodePrivate() override
+    {
+        /*
+            The renderer has already been notified about the node
+            being removed, so we can release the shared geometry now.
+         */
+        if ( m_isGeometryShared )
+        {
+            if ( auto cache = qskGeometryCache() )
+                cache->release( m_sharedKey );
+        }
+    }
+
     inline void resetNode( QskBoxRectangleNode* node )
     {
         m_metricsHash = m_colorsHash = 0;
+
+        m_borderColors = QskBoxBorderColors();
+        m_gradient = QskGradient();
+
+        releaseSharedGeometry( node );
         node->resetGeometry();
     }
 
     inline bool updateMetrics( const QRectF& rect,
         const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics )
     {
+        // the position is not part of the hash: see moveGeometry()
+
+        const auto size = rect.size();
+
         QskHashValue hash = 13000;
 
-        hash = qHashBits( &rect, sizeof( rect ), hash );
+        hash = qHashBits( &size, sizeof( size ), hash );
         hash = shape.hash( hash );
         hash = borderMetrics.hash( hash );
 
-        return updateHash( m_metricsHash, hash );
+        if ( updateHash( m_metricsHash, hash ) )
+        {
+            m_size = size;
+            m_shape = shape.toAbsolute( size );
+            m_borderMetrics = borderMetrics.toAbsolute( size );
+
+            return true;
+        }
+
+        /*
+            Shifting the vertices over and over accumulates rounding
+            errors of the float coordinates. So we tessellate again
+            from time to time.
+         */
+        return ( m_translationCount >= MaxTranslations )
+            && ( rect.topLeft() != m_position );
     }
 
-    inline bool updateColors(
+    template< typename Tessellate >
+    inline void updateGeometry( QskBoxRectangleNode* node,
+        const QPointF& pos, Content content, Tessellate tessellate )
+    {
+        releaseSharedGeometry( node );
+
+        const bool isColored = node->isGeometryColored();
+
+        auto cache = qskIsGeometrySharingEnabled() ? qskGeometryCache() : nullptr;
+        if ( cache == nullptr )
+        {
+            tessellate( *node->geometry() );
+            qskGeometryRebuilds.ref();
+        }
+        else
+        {
+            GeometryKey key;
+
+            key.size = m_size;
+            key.position = pos;
+            key.shape = m_shape;
+            key.borderMetrics = m_borderMetrics;
+            key.content = content;
+            key.isColored = isColored;
+
+            if ( isColored )
+            {
+                key.colorsHash = m_colorsHash;
+                key.borderColors = m_borderColors;
+                key.gradient = m_gradient;
+            }
+
+            auto geometry = cache->acquire( key );
+            if ( geometry )
+            {
+                qskGeometryShares.ref();
+            }
+            else
+            {
+                const auto& attributes = isColored
+                    ? QSGGeometry::defaultAttributes_ColoredPoint2D()
+                    : QSGGeometry::defaultAttributes_Point2D();
+
+                geometry = new QSGGeometry( attributes, 0 );
+                tessellate( *geometry );
+
+                geometry = cache->insert( key, geometry );
+
+                qskGeometryRebuilds.ref();
+            }
+
+            // the vertices of our own geometry are not needed anymore
+            m_ownGeometry->allocate( 0 );
+
+            node->setGeometry( geometry );
+
+            m_sharedKey = key;
+            m_isGeometryShared = true;
+        }
+
+        m_position = pos;
+        m_translationCount = 0;
+
+        node->markDirty( QSGNode::DirtyGeometry );
+    }
+
+    inline bool moveGeometry( QskBoxRectangleNode* node, const QPointF& pos )
+    {
+        if ( pos == m_position )
+            return false;
+
+        detachGeometry( node );
+
+        const auto dx = static_cast< float >( pos.x() - m_position.x() );
+        const auto dy = static_cast< float >( pos.y() - m_position.y() );
+
+        /*
+            Point2D and ColoredPoint2D both start with the
+            coordinates, so we can ignore the color attributes.
+         */
+        auto geometry = node->geometry();
+
+        auto data = static_cast< char* >( geometry->vertexData() );
+        const auto stride = geometry->sizeOfVertex();
+
+        for ( int i = 0; i < geometry->vertexCount(); i++ )
+        {
+            auto p = reinterpret_cast< float* >( data + i * stride );
+            p[0] += dx;
+            p[1] += dy;
+        }
+
+        node->markDirty( QSGNode::DirtyGeometry );
+
+        m_position = pos;
+        m_translationCount++;
+
+        qskGeometryTranslations.ref();
+
+        return true;
+    }
+
+    inline bool updateColors( const QRectF& rect,
         const QskBoxBorderColors& borderColors, const QskGradient& gradient )
     {
         QskHashValue hash = 13000;
 
+        bool isDirty = false;
+
+        const auto effectiveColors =
+            borderColors.isVisible() ? borderColors : QskBoxBorderColors();
+
+        const auto effectiveGradient =
+            gradient.isVisible() ? gradient : QskGradient();
+
+        // equal hash values do not guarantee equal colors
+
+        if ( effectiveColors != m_borderColors )
+        {
+            m_borderColors = effectiveColors;
+            isDirty = true;
+        }
+
+        if ( effectiveGradient != m_gradient )
+        {
+            m_gradient = effectiveGradient;
+            isDirty = true;
+        }
+
         if ( borderColors.isVisible() )
             hash = borderColors.hash( hash );
 
         if ( gradient.isVisible() )
+        {
             hash = gradient.hash( hash );
 
-        return updateHash( m_colorsHash, hash );
+            if ( gradient.stretchMode() == QskGradient::NoStretch
+                && !gradient.isMonochrome() )
+            {
+                // colors in item coordinates: depending on the position
+
+                const auto pos = rect.topLeft();
+                hash = qHashBits( &pos, sizeof( pos ), hash );
+            }
+        }
+
+        if ( updateHash( m_colorsHash, hash ) )
+            isDirty = true;
+
+        return isDirty;
     }
 
   private:
+    inline void detachGeometry( QskBoxRectangleNode* node )
+    {
+        if ( !m_isGeometryShared )
+            return;
+
+        // copy on write
+
+        const auto shared = node->geometry();
+
+        m_ownGeometry->allocate( shared->vertexCount() );
+        m_ownGeometry->setDrawingMode( shared->drawingMode() );
+
+        memcpy( m_ownGeometry->vertexData(), shared->vertexData(),
+            shared->vertexCount() * shared->sizeOfVertex() );
+
+        m_ownGeometry->markVertexDataDirty();
+
+        releaseSharedGeometry( node );
+    }
+
+    inline void releaseSharedGeometry( QskBoxRectangleNode* node )
+    {
+        if ( !m_isGeometryShared )
+            return;
+
+        node->setGeometry( m_ownGeometry );
+
+        if ( auto cache = qskGeometryCache() )
+            cache->release( m_sharedKey );
+
+        m_isGeometryShared = false;
+    }
+
     inline bool updateHash( QskHashValue& value, const QskHashValue newValue ) const
     {
         if ( newValue != value )
@@ -66,13 +435,36 @@ class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
     }
 
   public:
+    enum { MaxTranslations = 64 };
+
     QskHashValue m_metricsHash = 0;
     QskHashValue m_colorsHash = 0;
+
+    // the colors of the last update
+    QskBoxBorderColors m_borderColors;
+    QskGradient m_gradient;
+
+    // the metrics of the last tessellation
+    QSizeF m_size;
+    QskBoxShapeMetrics m_shape;
+    QskBoxBorderMetrics m_borderMetrics;
+
+    // the position of the box, when the geometry has been created
+    QPointF m_position;
+    int m_translationCount = 0;
+
+    // the geometry embedded in QskFillNodePrivate
+    QSGGeometry* m_ownGeometry = nullptr;
+
+    GeometryKey m_sharedKey;
+    bool m_isGeometryShared = false;
 };
 
 QskBoxRectangleNode::QskBoxRectangleNode()
     : QskFillNode( *new QskBoxRectangleNodePrivate )
 {
+    Q_D( QskBoxRectangleNode );
+    d->m_ownGeometry = geometry();
 }
 
 QskBoxRectangleNode::~QskBoxRectangleNode()
@@ -110,33 +502,44 @@ void QskBoxRectangleNode::updateFilling( const QRectF& rect,
         && QskBoxRenderer::isGradientSupported( fillGradient );
 
     bool dirtyGeometry = d->updateMetrics( rect, shape, borderMetrics );
-    bool dirtyMaterial = d->updateColors( QskBoxBorderColors(), fillGradient );
+    bool dirtyMaterial = d->updateColors( rect, QskBoxBorderColors(), fillGradient );
 
     if ( coloredGeometry != isGeometryColored() )
         dirtyGeometry = dirtyMaterial = true;
 
-    if ( dirtyGeometry || dirtyMaterial )
+    if ( coloredGeometry )
     {
-        if ( coloredGeometry )
+        if ( dirtyGeometry || dirtyMaterial )
         {
             setColoring( QskFillNode::Polychrome );
 
-            QskBoxRenderer::setColoredFillLines( rect, shape,
-                borderMetrics, fillGradient, *geometry() );
-
-            markDirty( QSGNode::DirtyGeometry );
+            d->updateGeometry( this, rect.topLeft(), QskBoxRectangleNodePrivate::Filling,
+                [ & ]( QSGGeometry& geometry )
+                {
+                    QskBoxRenderer::setColoredFillLines( rect, shape,
+                        borderMetrics, fillGradient, geometry );
+                } );
         }
         else
         {
-            setColoring( rect, fillGradient );
+            d->moveGeometry( this, rect.topLeft() );
+        }
+    }
+    else
+    {
+        const bool moved = !dirtyGeometry && d->moveGeometry( this, rect.topLeft() );
 
-            if ( dirtyGeometry )
-            {
-                QskBoxRenderer::setFillLines(
-                    rect, shape, borderMetrics, *geometry() );
+        // the gradient of the material is in item coordinates
+        if ( dirtyGeometry || dirtyMaterial || moved )
+            setColoring( rect, fillGradient );
 
-                markDirty( QSGNode::DirtyGeometry );
-            }
+        if ( dirtyGeometry )
+        {
+            d->updateGeometry( this, rect.topLeft(), QskBoxRectangleNodePrivate::Filling,
+                [ & ]( QSGGeometry& geometry )
+                {
+                    QskBoxRenderer::setFillLines( rect, shape, borderMetrics, geometry );
+                } );
         }
     }
 }
@@ -157,33 +560,45 @@ void QskBoxRectangleNode::updateBorder( const QRectF& rect,
         || !borderColors.isMonochrome();
 
     bool dirtyGeometry = d->updateMetrics( rect, shape, borderMetrics );
-    bool dirtyMaterial = d->updateColors( borderColors, QskGradient() );
+    bool dirtyMaterial = d->updateColors( rect, borderColors, QskGradient() );
 
     if ( coloredGeometry != isGeometryColored() )
         dirtyGeometry = dirtyMaterial = true;
 
-    if ( dirtyGeometry || dirtyMaterial )
+    if ( coloredGeometry )
     {
-        if ( coloredGeometry )
+        if ( dirtyGeometry || dirtyMaterial )
         {
             setColoring( QskFillNode::Polychrome );
 
-            QskBoxRenderer::setColoredBorderLines( rect, shape,
-                borderMetrics, borderColors, *geometry() );
-
-            markDirty( QSGNode::DirtyGeometry );
+            d->updateGeometry( this, rect.topLeft(), QskBoxRectangleNodePrivate::Border,
+                [ & ]( QSGGeometry& geometry )
+                {
+                    QskBoxRenderer::setColoredBorderLines( rect, shape,
+                        borderMetrics, borderColors, geometry );
+                } );
         }
         else
         {
+            d->moveGeometry( this, rect.topLeft() );
+        }
+    }
+    else
+    {
+        if ( dirtyGeometry || dirtyMaterial )
             setColoring( borderColors.left().rgbStart() );
 
-            if ( dirtyGeometry )
-            {
-                QskBoxRenderer::setBorderLines( rect, shape,
-                    borderMetrics, *geometry() );
-
-                markDirty( QSGNode::DirtyGeometry );
-            }
+        if ( dirtyGeometry )
+        {
+            d->updateGeometry( this, rect.topLeft(), QskBoxRectangleNodePrivate::Border,
+                [ & ]( QSGGeometry& geometry )
+                {
+                    QskBoxRenderer::setBorderLines( rect, shape, borderMetrics, geometry );
+                } );
+        }
+        else
+        {
+            d->moveGeometry( this, rect.topLeft() );
         }
     }
 }
@@ -205,10 +620,10 @@ void QskBoxRectangleNode::updateBox( const QRectF& rect,
 
     if ( hasFill && hasBorder )
     {
-        const bool isDirty = d->updateMetrics( rect, shape, borderMetrics )
-            || d->updateColors( borderColors, gradient ) || !isGeometryColored();
+        const bool dirtyGeometry = d->updateMetrics( rect, shape, borderMetrics );
+        const bool dirtyMaterial = d->updateColors( rect, borderColors, gradient );
 
-        if ( isDirty )
+        if ( dirtyGeometry || dirtyMaterial || !isGeometryColored() )
         {
             /*
                 For monochrome border/filling with the same color we might be
@@ -224,10 +639,17 @@ void QskBoxRectangleNode::updateBox( const QRectF& rect,
                 fillGradient.setDirection( QskGradient::Linear );
             }
 
-            QskBoxRenderer::setColoredBorderAndFillLines( rect, shape, borderMetrics,
-                borderColors, fillGradient, *geometry() );
-
-            markDirty( QSGNode::DirtyGeometry );
+            d->updateGeometry( this, rect.topLeft(),
+                QskBoxRectangleNodePrivate::BorderAndFilling,
+                [ & ]( QSGGeometry& geometry )
+                {
+                    QskBoxRenderer::setColoredBorderAndFillLines( rect, shape, borderMetrics,
+                        borderColors, fillGradient, geometry );
+                } );
+        }
+        else
+        {
+            d->moveGeometry( this, rect.topLeft() );
         }
     }
     else if ( hasFill )
@@ -248,3 +670,39 @@ bool QskBoxRectangleNode::isCombinedGeometrySupported( const QskGradient& gradie
 {
     return QskBoxRenderer::isGradientSupported( gradient );
 }
+
+QskBoxGeometryStatistics QskBoxRectangleNode::geometryStatistics()
+{
+    QskBoxGeometryStatistics statistics;
+
+    statistics.rebuilds = qskGeometryRebuilds.loadAcquire();
+    statistics.translations = qskGeometryTranslations.loadAcquire();
+    statistics.shares = qskGeometryShares.loadAcquire();
+
+    return statistics;
+}
+
+void QskBoxRectangleNode::resetGeometryStatistics()
+{
+    qskGeometryRebuilds.storeRelease( 0 );
+    qskGeometryTranslations.storeRelease( 0 );
+    qskGeometryShares.storeRelease( 0 );
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskBoxGeometryStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "BoxGeometry( rebuilds: " << statistics.rebuilds
+        << ", translations: " << statistics.translations
+        << ", shares: " << statistics.shares << " )";
+
+    return debug;
+}
+
+#endif
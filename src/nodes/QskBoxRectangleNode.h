@@ -16,6 +16,26 @@ class QskGradient;
 
 class QskBoxRectangleNodePrivate;
 
+class QSK_EXPORT QskBoxGeometryStatistics
+{
+  public:
+    // tessellations of the box by QskBoxRenderer
+    int rebuilds = 0;
+
+    // position only changes, where the vertices have been shifted
+    int translations = 0;
+
+    // geometries taken from other nodes with the same metrics
+    int shares = 0;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskBoxGeometryStatistics& );
+
+#endif
+
 class QSK_EXPORT QskBoxRectangleNode : public QskFillNode
 {
     using Inherited = QskFillNode;
@@ -47,6 +67,22 @@ class QSK_EXPORT QskBoxRectangleNode : public QskFillNode
      */
     static bool isCombinedGeometrySupported( const QskGradient& );
 
+    /*
+        The geometry depends on size, shape and border metrics only. When a box
+        is moving - f.e. during animated page transitions - the vertices are
+        shifted instead of running QskBoxRenderer again.
+
+        Nodes with the same metrics and position share their vertices,
+        what can be disabled by setting the environment variable
+        QSK_NO_SHARED_BOX_GEOMETRY.
+
+        The statistics are collected for all nodes, what might happen from
+        different scene graph threads. Resetting them after each frame
+        gives the number of rebuilds per frame.
+     */
+    static QskBoxGeometryStatistics geometryStatistics();
+    static void resetGeometryStatistics();
+
   private:
     Q_DECLARE_PRIVATE( QskBoxRectangleNode )
 };
@@ -10,6 +10,8 @@
 #include <qsgmaterialshader.h>
 #include <qsgmaterial.h>
 
+#include <cstring>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgnode_p.h>
 QSK_QT_PRIVATE_END
@@ -25,6 +27,53 @@ QSK_QT_PRIVATE_END
 
 namespace
 {
+    /*
+        The parameters of the shadow are passed as vertex attributes,
+        so that the material has no state and all shadows end up
+        in the same batch of the scene graph renderer.
+     */
+    class ShadowVertex
+    {
+      public:
+        float x, y;
+        float u, v;
+
+        // premultiplied
+        quint8 r, g, b, a;
+
+        float radius[ 4 ];
+
+        float aspectRatio[ 2 ];
+        float blurExtent;
+    };
+
+    static_assert( sizeof( ShadowVertex ) == 48, "ShadowVertex must not be padded" );
+
+    const QSGGeometry::AttributeSet& qskShadowAttributes()
+    {
+        using A = QSGGeometry::Attribute;
+
+        static const A attributes[] =
+        {
+            A::createWithAttributeType( 0, 2,
+                QSGGeometry::FloatType, QSGGeometry::PositionAttribute ),
+            A::createWithAttributeType( 1, 2,
+                QSGGeometry::FloatType, QSGGeometry::TexCoordAttribute ),
+            A::createWithAttributeType( 2, 4,
+                QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute ),
+            A::createWithAttributeType( 3, 4,
+                QSGGeometry::FloatType, QSGGeometry::UnknownAttribute ),
+            A::createWithAttributeType( 4, 3,
+                QSGGeometry::FloatType, QSGGeometry::UnknownAttribute )
+        };
+
+        // the renderer only merges geometries with the same attribute set
+        static const QSGGeometry::AttributeSet attributeSet =
+            { 5, sizeof( ShadowVertex ), attributes };
+
+        return attributeSet;
+    }
+
     class Material final : public QSGMaterial
     {
       public:
@@ -39,11 +88,6 @@ namespace
         QSGMaterialType* type() const override;
 
         int compare( const QSGMaterial* other ) const override;
-
-        QVector2D m_aspectRatio = QVector2D{ 1, 1 };
-        QVector4D m_radius = QVector4D{ 0, 0, 0, 0 };
-        QVector4D m_color = QVector4D{ 0, 0, 0, 1 };
-        float m_blurExtent = 0.0;
     };
 }
 
@@ -61,12 +105,9 @@ namespace
         }
 
         bool updateUniformData( RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+            QSGMaterial*, QSGMaterial* ) override
         {
-            const auto matOld = static_cast< Material* >( oldMaterial );
-            const auto matNew = static_cast< Material* >( newMaterial );
-
-            Q_ASSERT( state.uniformData()->size() >= 112 );
+            Q_ASSERT( state.uniformData()->size() >= 68 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -79,34 +120,10 @@ namespace
                 changed = true;
             }
 
-            if ( matOld == nullptr || matNew->m_color != matOld->m_color )
-            {
-                memcpy( data + 64, &matNew->m_color, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_radius != matOld->m_radius )
-            {
-                memcpy( data + 80, &matNew->m_radius, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_aspectRatio != matOld->m_aspectRatio )
-            {
-                memcpy( data + 96, &matNew->m_aspectRatio, 8 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_blurExtent != matOld->m_blurExtent )
-            {
-                memcpy( data + 104, &matNew->m_blurExtent, 4 );
-                changed = true;
-            }
-
             if ( state.isOpacityDirty() )
             {
                 const float opacity = state.opacity();
-                memcpy( data + 108, &opacity, 4 );
+                memcpy( data + 64, &opacity, 4 );
 
                 changed = true;
             }
@@ -135,7 +152,9 @@ namespace
 
         char const* const* attributeNames() const override
         {
-            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            static char const* const names[] = { "in_vertex", "in_coord",
+                "in_color", "in_radius", "in_parameters", nullptr };
+
             return names;
         }
 
@@ -146,15 +165,11 @@ namespace
             auto p = program();
 
             m_matrixId = p->uniformLocation( "matrix" );
-            m_aspectRatioId = p->uniformLocation( "aspectRatio" );
             m_opacityId = p->uniformLocation( "opacity" );
-            m_blurExtentId = p->uniformLocation( "blurExtent" );
-            m_radiusId = p->uniformLocation( "radius" );
-            m_colorId = p->uniformLocation( "color" );
         }
 
         void updateState( const QSGMaterialShader::RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override
+            QSGMaterial*, QSGMaterial* ) override
         {
             auto p = program();
 
@@ -163,30 +178,11 @@ namespace
 
             if ( state.isOpacityDirty() )
                 p->setUniformValue( m_opacityId, state.opacity() );
-
-            bool updateMaterial = ( oldMaterial == nullptr )
-                || newMaterial->compare( oldMaterial ) != 0;
-
-            updateMaterial |= state.isCachedMaterialDataDirty();
-
-            if ( updateMaterial )
-            {
-                auto material = static_cast< const Material* >( newMaterial );
-
-                p->setUniformValue( m_aspectRatioId, material->m_aspectRatio );
-                p->setUniformValue( m_blurExtentId, material->m_blurExtent);
-                p->setUniformValue( m_radiusId, material->m_radius );
-                p->setUniformValue( m_colorId, material->m_color );
-            }
         }
 
       private:
         int m_matrixId = -1;
         int m_opacityId = -1;
-        int m_aspectRatioId = -1;
-        int m_blurExtentId = -1;
-        int m_radiusId = -1;
-        int m_colorId = -1;
     };
 }
 
@@ -226,33 +222,23 @@ QSGMaterialType* Material::type() const
     return &staticType;
 }
 
-int Material::compare( const QSGMaterial* other ) const
+int Material::compare( const QSGMaterial* ) const
 {
-    auto material = static_cast< const Material* >( other );
-
-    if ( ( material->m_color == m_color )
-        && ( material->m_aspectRatio == m_aspectRatio )
-        && qFuzzyCompare(material->m_blurExtent, m_blurExtent)
-        && qFuzzyCompare(material->m_radius, m_radius) )
-    {
-        return 0;
-    }
-
-    return QSGMaterial::compare( other );
+    // all parameters are in the vertices
+    return 0;
 }
 
 class QskBoxShadowNodePrivate final : public QSGGeometryNodePrivate
 {
   public:
     QskBoxShadowNodePrivate()
-        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+        : geometry( qskShadowAttributes(), 4 )
     {
+        geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
     }
 
     QSGGeometry geometry;
     Material material;
-
-    QRectF rect;
 };
 
 QskBoxShadowNode::QskBoxShadowNode()
@@ -260,6 +246,8 @@ QskBoxShadowNode::QskBoxShadowNode()
 {
     Q_D( QskBoxShadowNode );
 
+    std::memset( d->geometry.vertexData(), 0, 4 * sizeof( ShadowVertex ) );
+
     setGeometry( &d->geometry );
     setMaterial( &d->material );
 }
@@ -274,72 +262,83 @@ void QskBoxShadowNode::setShadowData(
 {
     Q_D( QskBoxShadowNode );
 
-    if ( rect != d->rect )
-    {
-        d->rect = rect;
-
-        QSGGeometry::updateTexturedRectGeometry(
-            &d->geometry, d->rect, QRectF( -0.5, -0.5, 1.0, 1.0 ) );
+    ShadowVertex vertex;
 
-        d->geometry.markVertexDataDirty();
-        markDirty( QSGNode::DirtyGeometry );
-
-        QVector2D aspectRatio( 1.0, 1.0 );
+    {
+        vertex.aspectRatio[ 0 ] = vertex.aspectRatio[ 1 ] = 1.0f;
 
         if ( rect.width() >= rect.height() )
-            aspectRatio.setX( rect.width() / rect.height() );
+            vertex.aspectRatio[ 0 ] = rect.width() / rect.height();
         else
-            aspectRatio.setY( rect.height() / rect.width() );
-
-        if ( d->material.m_aspectRatio != aspectRatio )
-        {
-            d->material.m_aspectRatio = aspectRatio;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+            vertex.aspectRatio[ 1 ] = rect.height() / rect.width();
     }
 
     {
-        const float t = std::min( d->rect.width(), d->rect.height() );
+        const float t = std::min( rect.width(), rect.height() );
 
         const float r1 = shape.radius( Qt::BottomRightCorner ).width();
         const float r2 = shape.radius( Qt::TopRightCorner ).width();
         const float r3 = shape.radius( Qt::BottomLeftCorner ).width();
         const float r4 = shape.radius( Qt::TopLeftCorner ).width();
 
-        const auto uniformRadius = QVector4D(
-            std::min( r1 / t, 1.0f ), std::min( r2 / t, 1.0f ),
-            std::min( r3 / t, 1.0f ), std::min( r4 / t, 1.0f ) );
-
-        if ( d->material.m_radius != uniformRadius )
-        {
-            d->material.m_radius = uniformRadius;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        vertex.radius[ 0 ] = std::min( r1 / t, 1.0f );
+        vertex.radius[ 1 ] = std::min( r2 / t, 1.0f );
+        vertex.radius[ 2 ] = std::min( r3 / t, 1.0f );
+        vertex.radius[ 3 ] = std::min( r4 / t, 1.0f );
     }
 
     {
         if ( blurRadius <= 0.0 )
             blurRadius = 0.0;
 
-        const float t = 0.5 * std::min( d->rect.width(), d->rect.height() );
-        const float uniformExtent = blurRadius / t;
-
-        if ( !qFuzzyCompare( d->material.m_blurExtent, uniformExtent ) )
-        {
-            d->material.m_blurExtent = uniformExtent;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        const float t = 0.5 * std::min( rect.width(), rect.height() );
+        vertex.blurExtent = blurRadius / t;
     }
 
     {
-        const auto a = color.alphaF();
+        const auto c = color.toRgb();
+        const auto a = c.alpha();
 
-        const QVector4D c( color.redF() * a, color.greenF() * a, color.blueF() * a, a );
+        vertex.r = quint8( c.red() * a / 255 );
+        vertex.g = quint8( c.green() * a / 255 );
+        vertex.b = quint8( c.blue() * a / 255 );
+        vertex.a = quint8( a );
+    }
 
-        if ( d->material.m_color != c )
-        {
-            d->material.m_color = c;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+    const float x1 = rect.left();
+    const float y1 = rect.top();
+    const float x2 = rect.right();
+    const float y2 = rect.bottom();
+
+    ShadowVertex vertices[ 4 ] = { vertex, vertex, vertex, vertex };
+
+    vertices[ 0 ].x = x1;
+    vertices[ 0 ].y = y1;
+    vertices[ 0 ].u = -0.5f;
+    vertices[ 0 ].v = -0.5f;
+
+    vertices[ 1 ].x = x1;
+    vertices[ 1 ].y = y2;
+    vertices[ 1 ].u = -0.5f;
+    vertices[ 1 ].v = 0.5f;
+
+    vertices[ 2 ].x = x2;
+    vertices[ 2 ].y = y1;
+    vertices[ 2 ].u = 0.5f;
+    vertices[ 2 ].v = -0.5f;
+
+    vertices[ 3 ].x = x2;
+    vertices[ 3 ].y = y2;
+    vertices[ 3 ].u = 0.5f;
+    vertices[ 3 ].v = 0.5f;
+
+    auto data = d->geometry.vertexData();
+
+    if ( std::memcmp( data, vertices, sizeof( vertices ) ) != 0 )
+    {
+        std::memcpy( data, vertices, sizeof( vertices ) );
+
+        d->geometry.markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
     }
 }
@@ -14,6 +14,11 @@ class QskBoxShapeMetrics;
 
 class QskBoxShadowNodePrivate;
 
+/*
+    The shadow parameters are stored in the vertices, so that all
+    shadows share the same material state and can be merged into
+    a single batch by the scene graph renderer.
+ */
 class QSK_EXPORT QskBoxShadowNode : public QSGGeometryNode
 {
   public:
@@ -7,6 +7,15 @@
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskPainterCommand.h"
+#include "QskTextureCache.h"
+#include "QskTextureRenderer.h"
+
+static inline void qskRenderGraphic( QPainter* painter, const QSize& size,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    const QRectF rect( 0, 0, size.width(), size.height() );
+    graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+}
 
 namespace
 {
@@ -16,10 +25,62 @@ namespace
         const QskGraphic& graphic;
         const QskColorFilter& colorFilter;
     };
+
+    class PaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        /*
+            QskGraphic and QskColorFilter are implicitly shared and
+            rendering does not modify them. So copies can be safely
+            used from a worker thread.
+         */
+        PaintHelper( const QskGraphic& graphic, const QskColorFilter& colorFilter )
+            : m_graphic( graphic )
+            , m_colorFilter( colorFilter )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            qskRenderGraphic( painter, size, m_graphic, m_colorFilter );
+        }
+
+      private:
+        const QskGraphic m_graphic;
+        const QskColorFilter m_colorFilter;
+    };
+
+    class GraphicContent : public QskTextureCache::Content
+    {
+      public:
+        GraphicContent( const QskGraphic& graphic, const QskColorFilter& colorFilter )
+            : graphic( graphic )
+            , colorFilter( colorFilter )
+        {
+        }
+
+        bool isEqual( const QskTextureCache::Content& other ) const override
+        {
+            /*
+                Comparing graphics is cheap as QskGraphic::operator==
+                only checks the modification id, the render hints
+                and the view box.
+             */
+            const auto content = dynamic_cast< const GraphicContent* >( &other );
+
+            return content && ( content->graphic == graphic )
+                && ( content->colorFilter == colorFilter );
+        }
+
+        const QskGraphic graphic;
+        const QskColorFilter colorFilter;
+    };
 }
 
 QskGraphicNode::QskGraphicNode()
 {
+    // identical graphics share the same texture
+    setTextureCached( true );
 }
 
 QskGraphicNode::~QskGraphicNode()
@@ -48,12 +109,23 @@ void QskGraphicNode::setGraphic( QQuickWindow* window, const QskGraphic& graphic
 void QskGraphicNode::paint( QPainter* painter, const QSize& size, const void* nodeData )
 {
     const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+    qskRenderGraphic( painter, size, graphicData->graphic, graphicData->colorFilter );
+}
 
-    const auto& graphic = graphicData->graphic;
-    const auto& colorFilter = graphicData->colorFilter;
+QskTextureRenderer::PaintHelper* QskGraphicNode::createPaintHelper(
+    const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+    return new PaintHelper( graphicData->graphic, graphicData->colorFilter );
+}
 
-    const QRectF rect( 0, 0, size.width(), size.height() );
-    graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+std::shared_ptr< const QskTextureCache::Content > QskGraphicNode::cacheContent(
+    const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+
+    return std::make_shared< GraphicContent >(
+        graphicData->graphic, graphicData->colorFilter );
 }
 
 QskHashValue QskGraphicNode::hash( const void* nodeData ) const
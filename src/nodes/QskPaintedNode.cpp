@@ -5,12 +5,18 @@
 
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
+#include "QskTextureCache.h"
 #include "QskTextureRenderer.h"
 
 #include <qsgimagenode.h>
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qrunnable.h>
+#include <qthread.h>
+#include <qthreadpool.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -30,6 +36,27 @@ static inline QSGImageNode::TextureCoordinatesTransformMode
     return mode;
 }
 
+template< typename Paint >
+static QImage qskCreateImage( const QSize& size, qreal ratio, Paint paint )
+{
+    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QPainter painter( &image );
+
+    /*
+        setting a devicePixelRatio for the image only works for
+        value >= 1.0. So we have to scale manually.
+     */
+    painter.scale( ratio, ratio );
+
+    paint( &painter, size / ratio );
+
+    painter.end();
+
+    return image;
+}
+
 namespace
 {
     const quint8 imageRole = 250; // reserved for internal use
@@ -41,14 +68,118 @@ namespace
 
         return static_cast< QSGImageNode* >( node );
     }
+
+    inline bool hasCachedTexture( const QSGImageNode* imageNode )
+    {
+        return imageNode && imageNode->texture() && !imageNode->ownsTexture();
+    }
+
+    class ThreadPool : public QThreadPool
+    {
+      public:
+        ThreadPool()
+        {
+            // leaving some headroom for the render thread
+            setMaxThreadCount( qMax( 1, QThread::idealThreadCount() - 1 ) );
+        }
+    };
 }
 
+Q_GLOBAL_STATIC( ThreadPool, qskPaintThreadPool )
+
+/*
+    State shared between the node and its paint jobs. The job has
+    to know, when it has become obsolete, and the node has to be able
+    to pick up the result, even if the job is still running.
+ */
+class QskPaintedNode::AsyncData
+{
+  public:
+    inline bool isPending( QskHashValue hash, const QSize& size ) const
+    {
+        return ( window != nullptr ) && ( hash == this->hash ) && ( size == this->size );
+    }
+
+    QMutex mutex;
+
+    // reset, when the node is destroyed
+    QQuickWindow* window = nullptr;
+
+    // the pending job
+    QskHashValue hash = 0;
+    QSize size;
+
+    // the result of the pending job
+    QImage image;
+    bool isReady = false;
+};
+
+class QskPaintedNode::PaintJob final : public QRunnable
+{
+    using PaintHelper = QskTextureRenderer::PaintHelper;
+
+  public:
+    PaintJob( const std::shared_ptr< AsyncData >& data, PaintHelper* helper,
+            QskHashValue hash, const QSize& size, qreal ratio )
+        : m_data( data )
+        , m_helper( helper )
+        , m_hash( hash )
+        , m_size( size )
+        , m_ratio( ratio )
+    {
+        setAutoDelete( true );
+    }
+
+    void run() override
+    {
+        if ( !isPending() )
+            return;
+
+        const auto image = qskCreateImage( m_size, m_ratio,
+            [this]( QPainter* painter, const QSize& size )
+            { m_helper->paint( painter, size ); } );
+
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( m_data->isPending( m_hash, m_size ) )
+        {
+            m_data->image = image;
+            m_data->isReady = true;
+
+            /*
+                The texture is exchanged in QskPaintedNode::preprocess,
+                what happens when rendering the next frame.
+             */
+            QMetaObject::invokeMethod( m_data->window, "update", Qt::QueuedConnection );
+        }
+    }
+
+  private:
+    bool isPending() const
+    {
+        QMutexLocker locker( &m_data->mutex );
+        return m_data->isPending( m_hash, m_size );
+    }
+
+    const std::shared_ptr< AsyncData > m_data;
+    const std::unique_ptr< PaintHelper > m_helper;
+
+    const QskHashValue m_hash;
+    const QSize m_size;
+    const qreal m_ratio;
+};
+
 QskPaintedNode::QskPaintedNode()
 {
 }
 
 QskPaintedNode::~QskPaintedNode()
 {
+    cancelPaintJob();
+
+    const auto imageNode = findImageNode( this );
+    if ( hasCachedTexture( imageNode ) )
+        QskTextureCache::release( imageNode->texture() );
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -80,6 +211,63 @@ Qt::Orientations QskPaintedNode::mirrored() const
     return m_mirrored;
 }
 
+void QskPaintedNode::setTextureCached( bool on )
+{
+    if ( on != m_textureCached )
+    {
+        m_textureCached = on;
+        m_hash = 0; // enforce an update of the texture
+    }
+}
+
+bool QskPaintedNode::isTextureCached() const
+{
+    return m_textureCached;
+}
+
+void QskPaintedNode::setAtlasEnabled( bool on )
+{
+    if ( on != m_atlasEnabled )
+    {
+        m_atlasEnabled = on;
+        m_hash = 0; // enforce an update of the texture
+    }
+}
+
+bool QskPaintedNode::isAtlasEnabled() const
+{
+    return m_atlasEnabled;
+}
+
+void QskPaintedNode::setAsynchronous( bool on )
+{
+    if ( on != m_asynchronous )
+    {
+        m_asynchronous = on;
+
+        if ( !on )
+        {
+            cancelPaintJob();
+            m_hash = 0; // enforce an update of the texture
+        }
+    }
+}
+
+bool QskPaintedNode::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+bool QskPaintedNode::useAtlas( const QSize& size ) const
+{
+    return m_atlasEnabled && QskTextureRenderer::isAtlasCandidate( size );
+}
+
+bool QskPaintedNode::useOpenGL( const QQuickWindow* window ) const
+{
+    return ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window );
+}
+
 QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
@@ -104,8 +292,13 @@ void QskPaintedNode::update( QQuickWindow* window,
 
     if ( rect.isEmpty() )
     {
+        cancelPaintJob();
+
         if ( imageNode )
         {
+            if ( hasCachedTexture( imageNode ) )
+                QskTextureCache::release( imageNode->texture() );
+
             removeChildNode( imageNode );
             delete imageNode;
         }
@@ -139,6 +332,11 @@ void QskPaintedNode::update( QQuickWindow* window,
     {
         m_hash = newHash;
         isTextureDirty = true;
+
+        if ( m_textureCached && m_hash != 0 )
+            m_cacheContent = cacheContent( nodeData );
+        else
+            m_cacheContent.reset();
     }
     else
     {
@@ -157,9 +355,44 @@ void QskPaintedNode::update( QQuickWindow* window,
 void QskPaintedNode::updateTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
+    if ( m_asynchronous && m_hash != 0 && !useOpenGL( window ) )
+    {
+        if ( useTextureCache() )
+        {
+            if ( auto texture = QskTextureCache::acquire( window, cacheKey( window, size ) ) )
+            {
+                cancelPaintJob();
+                setCachedTexture( texture );
+
+                return;
+            }
+        }
+
+        if ( startPaintJob( window, size, nodeData ) )
+            return;
+    }
+
+    cancelPaintJob();
+
+    if ( useTextureCache() )
+    {
+        updateCachedTexture( window, size, nodeData );
+        return;
+    }
+
     auto imageNode = findImageNode( this );
 
-    if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
+    if ( hasCachedTexture( imageNode ) || useAtlas( size ) )
+    {
+        /*
+            We must not modify a texture, that might be shared
+            and atlas textures can't be updated at all.
+         */
+        setOwnedTexture( createTexture( window, size, nodeData ) );
+        return;
+    }
+
+    if ( useOpenGL( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
 
@@ -186,26 +419,251 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
     }
 }
 
-QImage QskPaintedNode::createImage( QQuickWindow* window,
+void QskPaintedNode::updateCachedTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
-    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
-    image.fill( Qt::transparent );
+    const auto key = cacheKey( window, size );
 
-    QPainter painter( &image );
+    auto texture = QskTextureCache::acquire( window, key );
+    if ( texture == nullptr )
+    {
+        texture = QskTextureCache::insert(
+            window, key, createTexture( window, size, nodeData ) );
+    }
+
+    setCachedTexture( texture );
+}
 
+bool QskPaintedNode::useTextureCache() const
+{
+    return m_textureCached && ( m_hash != 0 ) && m_cacheContent;
+}
+
+QskTextureCache::Key QskPaintedNode::cacheKey(
+    const QQuickWindow* window, const QSize& size ) const
+{
     /*
-        setting a devicePixelRatio for the image only works for
-        value >= 1.0. So we have to scale manually.
+        The texture depends on the device pixel ratio and
+        the way how the texture is created as well
      */
-    const auto ratio = window->effectiveDevicePixelRatio();
-    painter.scale( ratio, ratio );
+    QskTextureCache::Key key;
+    key.hash = m_hash;
+    key.size = size;
+    key.devicePixelRatio = window->effectiveDevicePixelRatio();
+    key.textureType = ( useOpenGL( window ) ? 1 : 0 ) | ( useAtlas( size ) ? 2 : 0 );
+    key.content = m_cacheContent;
+
+    return key;
+}
 
-    paint( &painter, size / ratio, nodeData );
+void QskPaintedNode::setOwnedTexture( QSGTexture* texture )
+{
+    auto imageNode = findImageNode( this );
 
-    painter.end();
+    if ( hasCachedTexture( imageNode ) )
+    {
+        const auto oldTexture = imageNode->texture();
 
-    return image;
+        imageNode->setTexture( texture );
+        imageNode->setOwnsTexture( true );
+
+        QskTextureCache::release( oldTexture );
+    }
+    else
+    {
+        // deletes the previous texture
+        imageNode->setTexture( texture );
+    }
+}
+
+void QskPaintedNode::setCachedTexture( QSGTexture* texture )
+{
+    // the reference counter of the texture has already been increased
+
+    auto imageNode = findImageNode( this );
+
+    const auto oldTexture = imageNode->texture();
+    if ( oldTexture == texture )
+    {
+        // we already had a reference
+        QskTextureCache::release( texture );
+        return;
+    }
+
+    const bool ownedTexture = imageNode->ownsTexture();
+
+    imageNode->setOwnsTexture( false );
+    imageNode->setTexture( texture );
+
+    if ( oldTexture )
+    {
+        if ( ownedTexture )
+            delete oldTexture;
+        else
+            QskTextureCache::release( oldTexture );
+    }
+}
+
+bool QskPaintedNode::startPaintJob( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    if ( m_asyncData )
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+        if ( m_asyncData->isPending( m_hash, size ) )
+            return true; // the texture is already on its way
+    }
+
+    auto helper = createPaintHelper( nodeData );
+    if ( helper == nullptr )
+        return false;
+
+    if ( m_asyncData == nullptr )
+        m_asyncData = std::make_shared< AsyncData >();
+
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        // jobs for other hash values or sizes will drop their results
+        m_asyncData->window = window;
+        m_asyncData->hash = m_hash;
+        m_asyncData->size = size;
+        m_asyncData->image = QImage();
+        m_asyncData->isReady = false;
+    }
+
+    auto imageNode = findImageNode( this );
+    if ( imageNode->texture() == nullptr )
+    {
+        // a transparent placeholder, until the job has been finished
+        QImage image( 1, 1, QImage::Format_RGBA8888_Premultiplied );
+        image.fill( Qt::transparent );
+
+        imageNode->setTexture( window->createTextureFromImage( image ) );
+    }
+
+    setFlag( QSGNode::UsePreprocess, true );
+
+    qskPaintThreadPool->start( new PaintJob( m_asyncData, helper,
+        m_hash, size, window->effectiveDevicePixelRatio() ) );
+
+    return true;
+}
+
+void QskPaintedNode::cancelPaintJob()
+{
+    if ( m_asyncData )
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        m_asyncData->window = nullptr;
+        m_asyncData->hash = 0;
+        m_asyncData->image = QImage();
+        m_asyncData->isReady = false;
+    }
+
+    if ( flags() & QSGNode::UsePreprocess )
+        setFlag( QSGNode::UsePreprocess, false );
+}
+
+void QskPaintedNode::preprocess()
+{
+    if ( m_asyncData == nullptr )
+        return;
+
+    QQuickWindow* window;
+    QImage image;
+
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        if ( !m_asyncData->isReady )
+            return;
+
+        window = m_asyncData->window;
+        image = m_asyncData->image;
+
+        m_asyncData->window = nullptr;
+        m_asyncData->hash = 0;
+        m_asyncData->image = QImage();
+        m_asyncData->isReady = false;
+    }
+
+    setFlag( QSGNode::UsePreprocess, false );
+
+    if ( findImageNode( this ) == nullptr || window == nullptr )
+        return;
+
+    auto texture = createTextureFromImage( window, image );
+
+    if ( useTextureCache() )
+    {
+        texture = QskTextureCache::insert(
+            window, cacheKey( window, image.size() ), texture );
+
+        setCachedTexture( texture );
+    }
+    else
+    {
+        setOwnedTexture( texture );
+    }
+}
+
+QskTextureRenderer::PaintHelper* QskPaintedNode::createPaintHelper( const void* ) const
+{
+    return nullptr;
+}
+
+std::shared_ptr< const QskTextureCache::Content > QskPaintedNode::cacheContent(
+    const void* ) const
+{
+    return nullptr;
+}
+
+QSGTexture* QskPaintedNode::createTextureFromImage(
+    QQuickWindow* window, const QImage& image ) const
+{
+    if ( useAtlas( image.size() ) )
+    {
+        return window->createTextureFromImage( image,
+            QQuickWindow::TextureHasAlphaChannel | QQuickWindow::TextureCanUseAtlas );
+    }
+
+    return window->createTextureFromImage( image );
+}
+
+QSGTexture* QskPaintedNode::createTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    if ( useAtlas( size ) )
+    {
+        const auto image = createImage( window, size, nodeData );
+        return createTextureFromImage( window, image );
+    }
+
+    if ( useOpenGL( window ) )
+    {
+        const auto textureId = createTextureGL( window, size, nodeData );
+
+        auto texture = new QSGPlainTexture;
+        texture->setHasAlphaChannel( true );
+        texture->setOwnsTexture( true );
+
+        QskTextureRenderer::setTextureId( window, textureId, size, texture );
+
+        return texture;
+    }
+
+    const auto image = createImage( window, size, nodeData );
+    return window->createTextureFromImage( image );
+}
+
+QImage QskPaintedNode::createImage( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    return qskCreateImage( size, window->effectiveDevicePixelRatio(),
+        [this, nodeData]( QPainter* painter, const QSize& size )
+        { paint( painter, size, nodeData ); } );
 }
 
 quint32 QskPaintedNode::createTextureGL(
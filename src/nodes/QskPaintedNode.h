@@ -8,10 +8,23 @@
 
 #include "QskGlobal.h"
 #include <qsgnode.h>
+#include <memory>
 
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
+
+namespace QskTextureRenderer
+{
+    class PaintHelper;
+}
+
+namespace QskTextureCache
+{
+    class Content;
+    class Key;
+}
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -42,6 +55,36 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
+    /*
+        Nodes with the same content and texture size share their texture.
+        Only nodes implementing cacheContent() can be cached.
+        See QskTextureCache.
+     */
+    void setTextureCached( bool );
+    bool isTextureCached() const;
+
+    /*
+        Small textures, that do not exceed QskTextureRenderer::atlasSizeLimit(),
+        are rasterized into the atlas of the scene graph, so that the renderer
+        is able to batch the image nodes. Textures from the atlas are always
+        painted by the raster paint engine.
+     */
+    void setAtlasEnabled( bool );
+    bool isAtlasEnabled() const;
+
+    /*
+        In asynchronous mode the raster paint engine paints the content
+        from a worker thread, while the previous texture - or an empty
+        placeholder - is displayed. Jobs for an outdated hash value
+        are dropped.
+
+        Only nodes implementing createPaintHelper() can be painted
+        asynchronously. OpenGL and a hash value of '0' always result
+        in synchronous painting.
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
     QRectF rect() const;
     QSize textureSize() const;
 
@@ -53,8 +96,44 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
+    /*
+        A helper for painting the content from a worker thread. It must not
+        refer to nodeData, as it might be used after update() has returned.
+        The default implementation returns nullptr.
+     */
+    virtual QskTextureRenderer::PaintHelper* createPaintHelper(
+        const void* nodeData ) const;
+
+    /*
+        A description of the content, that can be compared with the
+        content of other nodes. The default implementation returns nullptr.
+     */
+    virtual std::shared_ptr< const QskTextureCache::Content > cacheContent(
+        const void* nodeData ) const;
+
+    void preprocess() override;
+
   private:
+    class AsyncData;
+    class PaintJob;
+
+    bool startPaintJob( QQuickWindow*, const QSize&, const void* nodeData );
+    void cancelPaintJob();
+
+    void setOwnedTexture( QSGTexture* );
+    void setCachedTexture( QSGTexture* );
+    QskTextureCache::Key cacheKey( const QQuickWindow*, const QSize& ) const;
+    bool useTextureCache() const;
+
+    QSGTexture* createTextureFromImage( QQuickWindow*, const QImage& ) const;
+
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    void updateCachedTexture( QQuickWindow*, const QSize&, const void* nodeData );
+
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
+
+    bool useAtlas( const QSize& ) const;
+    bool useOpenGL( const QQuickWindow* ) const;
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
@@ -62,6 +141,13 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
     QskHashValue m_hash = 0;
+
+    bool m_textureCached = false;
+    bool m_atlasEnabled = false;
+    bool m_asynchronous = false;
+
+    std::shared_ptr< const QskTextureCache::Content > m_cacheContent;
+    std::shared_ptr< AsyncData > m_asyncData;
 };
 
 #endif
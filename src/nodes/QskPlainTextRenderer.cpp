@@ -7,9 +7,18 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
+#include <qcoreapplication.h>
 #include <qfontmetrics.h>
+#include <qglyphrun.h>
 #include <qmath.h>
+#include <qmutex.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #include <qsgnode.h>
+#include <qthreadpool.h>
+
+#include <limits>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -17,6 +26,218 @@ QSK_QT_PRIVATE_END
 
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
+static void qskCleanupTextCache();
+
+namespace
+{
+    class Key
+    {
+      public:
+        enum Type : quint8
+        {
+            TextRect,
+            TextLayout
+        };
+
+        inline bool operator==( const Key& other ) const
+        {
+            return ( type == other.type ) && ( alignment == other.alignment )
+                && ( options == other.options ) && ( size == other.size )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        Type type;
+        int alignment;
+        QskTextOptions options;
+        QSizeF size;
+
+        QString text;
+        QFont font;
+    };
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 ) noexcept
+    {
+        auto hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = key.options.hash( hash );
+        hash = ::qHash( key.alignment, hash );
+        hash = ::qHash( int( key.type ), hash );
+
+        return qHashBits( &key.size, sizeof( key.size ), hash );
+    }
+
+    // the result of laying out and shaping the text
+    class Layout
+    {
+      public:
+        QList< QGlyphRun > glyphRuns;
+
+        qreal textHeight = 0.0;
+        qreal boundingHeight = 0.0;
+    };
+
+    class Entry
+    {
+      public:
+        QRectF rect;
+        Layout layout;
+    };
+
+    class TextCache
+    {
+      public:
+        TextCache()
+        {
+            m_cache.setMaxCost( 4 * 1024 * 1024 );
+
+            // fonts and layouts must not outlive the application
+            qAddPostRoutine( qskCleanupTextCache );
+        }
+
+        bool find( const Key& key, Entry& entry )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( auto cachedEntry = m_cache.object( key ) )
+            {
+                m_statistics.hits++;
+                entry = *cachedEntry;
+
+                return true;
+            }
+
+            m_statistics.misses++;
+            return false;
+        }
+
+        bool contains( const Key& key ) const
+        {
+            QMutexLocker locker( &m_mutex );
+            return m_cache.contains( key );
+        }
+
+        void insert( const Key& key, const Entry& entry )
+        {
+            const auto cost = estimatedCost( key, entry );
+
+            QMutexLocker locker( &m_mutex );
+
+            const auto count = m_cache.count() + ( m_cache.contains( key ) ? 0 : 1 );
+
+            m_cache.insert( key, new Entry( entry ), cost );
+
+            if ( m_cache.count() < count )
+                m_statistics.evictions += count - m_cache.count();
+        }
+
+        void setMaxBytes( qint64 maxBytes )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            const auto count = m_cache.count();
+            m_cache.setMaxCost( qBound( qint64( 0 ), maxBytes,
+                qint64( std::numeric_limits< int >::max() ) ) );
+
+            m_statistics.evictions += count - m_cache.count();
+        }
+
+        qint64 maxBytes() const
+        {
+            QMutexLocker locker( &m_mutex );
+            return m_cache.maxCost();
+        }
+
+        QskPlainTextRenderer::CacheStatistics statistics() const
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto statistics = m_statistics;
+            statistics.bytes = m_cache.totalCost();
+            statistics.count = m_cache.count();
+
+            return statistics;
+        }
+
+        void resetStatistics()
+        {
+            QMutexLocker locker( &m_mutex );
+            m_statistics = QskPlainTextRenderer::CacheStatistics();
+        }
+
+        void clear()
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.clear();
+        }
+
+      private:
+        static int estimatedCost( const Key& key, const Entry& entry )
+        {
+            // a rough estimation of the memory being in use
+
+            int cost = sizeof( Key ) + sizeof( Entry ) + key.text.size() * sizeof( QChar );
+
+            for ( const auto& glyphRun : entry.layout.glyphRuns )
+            {
+                cost += sizeof( QGlyphRun ) + glyphRun.glyphIndexes().size()
+                    * int( sizeof( quint32 ) + sizeof( QPointF ) );
+            }
+
+            return cost;
+        }
+
+        mutable QMutex m_mutex;
+
+        QCache< Key, Entry > m_cache;
+        QskPlainTextRenderer::CacheStatistics m_statistics;
+    };
+}
+
+Q_GLOBAL_STATIC( TextCache, qskTextCache )
+
+static void qskCleanupTextCache()
+{
+    if ( !qskTextCache.isDestroyed() )
+        qskTextCache->clear();
+}
+
+namespace
+{
+    class MeasureJob : public QRunnable
+    {
+      public:
+        using Requests = QVector< const QskPlainTextRenderer::TextRequest* >;
+
+        MeasureJob( const Requests& requests, QAtomicInt& next, QSemaphore* semaphore )
+            : m_requests( requests )
+            , m_next( next )
+            , m_semaphore( semaphore )
+        {
+        }
+
+        void run() override
+        {
+            // jobs are picking the texts one by one until all are measured
+            for ( int i = m_next.fetchAndAddRelaxed( 1 );
+                i < m_requests.count(); i = m_next.fetchAndAddRelaxed( 1 ) )
+            {
+                const auto request = m_requests[ i ];
+
+                ( void ) QskPlainTextRenderer::textSize(
+                    request->text, request->font, request->options );
+            }
+
+            if ( m_semaphore )
+                m_semaphore->release();
+        }
+
+      private:
+        const Requests& m_requests;
+        QAtomicInt& m_next;
+        QSemaphore* m_semaphore;
+    };
+}
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
@@ -28,10 +249,97 @@ QRectF QskPlainTextRenderer::textRect(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
-    const QFontMetricsF fm( font );
-    const QRectF r( 0, 0, size.width(), size.height() );
+    const Key key { Key::TextRect, 0, options, size, text, font };
+
+    Entry entry;
+
+    if ( !qskTextCache->find( key, entry ) )
+    {
+        const QFontMetricsF fm( font );
+        const QRectF r( 0, 0, size.width(), size.height() );
+
+        entry.rect = fm.boundingRect( r, options.textFlags(), text );
+        qskTextCache->insert( key, entry );
+    }
+
+    return entry.rect;
+}
+
+void QskPlainTextRenderer::precomputeTextSizes( const QVector< TextRequest >& requests )
+{
+    /*
+        For a few texts the overhead of the threads is not worth it
+        and the texts will be measured, when being needed.
+     */
+    const int minJobSize = 4;
+
+    MeasureJob::Requests pendingRequests;
+
+    for ( const auto& request : requests )
+    {
+        const Key key { Key::TextRect, 0, request.options,
+            QSizeF( 10e6, 10e6 ), request.text, request.font };
+
+        if ( !qskTextCache->contains( key ) )
+            pendingRequests += &request;
+    }
+
+    if ( pendingRequests.count() < 2 * minJobSize )
+        return;
+
+    auto pool = QThreadPool::globalInstance();
+
+    const int jobCount = qMin( pool->maxThreadCount(),
+        int( pendingRequests.count() / minJobSize ) ) - 1;
+
+    QAtomicInt next( 0 );
+    QSemaphore semaphore;
+
+    int startedJobs = 0;
+
+    for ( int i = 0; i < jobCount; i++ )
+    {
+        auto job = new MeasureJob( pendingRequests, next, &semaphore );
+        job->setAutoDelete( true );
+
+        if ( !pool->tryStart( job ) )
+        {
+            delete job;
+            break;
+        }
+
+        startedJobs++;
+    }
+
+    // the calling thread is measuring too
+    MeasureJob( pendingRequests, next, nullptr ).run();
+
+    semaphore.acquire( startedJobs );
+}
+
+void QskPlainTextRenderer::setCacheMaxBytes( qint64 maxBytes )
+{
+    qskTextCache->setMaxBytes( maxBytes );
+}
+
+qint64 QskPlainTextRenderer::cacheMaxBytes()
+{
+    return qskTextCache->maxBytes();
+}
 
-    return fm.boundingRect( r, options.textFlags(), text );
+QskPlainTextRenderer::CacheStatistics QskPlainTextRenderer::cacheStatistics()
+{
+    return qskTextCache->statistics();
+}
+
+void QskPlainTextRenderer::resetCacheStatistics()
+{
+    qskTextCache->resetStatistics();
+}
+
+void QskPlainTextRenderer::clearCache()
+{
+    qskTextCache->clear();
 }
 
 static qreal qskLayoutText( QTextLayout* layout,
@@ -94,9 +402,53 @@ static qreal qskLayoutText( QTextLayout* layout,
     return y;
 }
 
+static Layout qskCreateLayout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width )
+{
+    QTextOption textOption( alignment );
+    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+
+    QString tmp = text;
+
+#if 0
+    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
+    if ( pos != -1 )
+    {
+        // ST: string termination
+
+        tmp = tmp.mid( 0, pos );
+        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
+    }
+    else
+#endif
+    if ( tmp.contains( QLatin1Char( '\n' ) ) )
+    {
+        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+    }
+
+    QTextLayout textLayout;
+    textLayout.setFont( font );
+    textLayout.setTextOption( textOption );
+    textLayout.setText( tmp );
+
+    Layout layout;
+
+    textLayout.beginLayout();
+    layout.textHeight = qskLayoutText( &textLayout, width, options );
+    textLayout.endLayout();
+
+    layout.boundingHeight = textLayout.boundingRect().height();
+
+    for ( int i = 0; i < textLayout.lineCount(); ++i )
+        layout.glyphRuns += textLayout.lineAt( i ).glyphRuns();
+
+    return layout;
+}
+
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
-    const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
+    QQuickItem* item, QSGNode* parentNode, const QList< QGlyphRun >& glyphRuns,
+    qreal baseLine, const QColor& color, QQuickText::TextStyle style,
+    const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
     auto sgContext = renderContext->sceneGraphContext();
@@ -118,49 +470,44 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRun : glyphRuns )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
-
-        for ( const auto& glyphRun : glyphRuns )
+        if ( glyphNode == nullptr )
         {
-            if ( glyphNode == nullptr )
-            {
-                const bool preferNativeGlyphNode = false; // QskTextOptions?
-                constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
+            const bool preferNativeGlyphNode = false; // QskTextOptions?
+            constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
-                const auto renderType = preferNativeGlyphNode
-                    ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, renderType, renderQuality );
+            const auto renderType = preferNativeGlyphNode
+                ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, renderType, renderQuality );
 #elif QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode, renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode, renderQuality );
 #else
-                Q_UNUSED( renderQuality );
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode );
+            Q_UNUSED( renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode );
 #endif
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 7, 0 )
-                glyphNode->setOwnerElement( item );
+            glyphNode->setOwnerElement( item );
 #endif
 
-                glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
-            }
+            glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
+        }
 
-            glyphNode->setStyle( style );
-            glyphNode->setColor( color );
-            glyphNode->setStyleColor( styleColor );
-            glyphNode->setGlyphs( position, glyphRun );
-            glyphNode->update();
+        glyphNode->setStyle( style );
+        glyphNode->setColor( color );
+        glyphNode->setStyleColor( styleColor );
+        glyphNode->setGlyphs( position, glyphRun );
+        glyphNode->update();
 
-            if ( glyphNode->parent() != parentNode )
-                parentNode->appendChildNode( glyphNode );
+        if ( glyphNode->parent() != parentNode )
+            parentNode->appendChildNode( glyphNode );
 
-            glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
-        }
+        glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 
     // Remove leftover glyphs
@@ -182,36 +529,19 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     Qt::Alignment alignment, const QRectF& rect,
     const QQuickItem* item, QSGTransformNode* node )
 {
-    QTextOption textOption( alignment );
-    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+    const Key key { Key::TextLayout, static_cast< int >( alignment ),
+        options, QSizeF( rect.width(), 0.0 ), text, font };
 
-    QString tmp = text;
+    Entry entry;
 
-#if 0
-    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
-    if ( pos != -1 )
-    {
-        // ST: string termination
-
-        tmp = tmp.mid( 0, pos );
-        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
-    }
-    else
-#endif
-    if ( tmp.contains( QLatin1Char( '\n' ) ) )
+    if ( !qskTextCache->find( key, entry ) )
     {
-        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+        entry.layout = qskCreateLayout( text, font, options, alignment, rect.width() );
+        qskTextCache->insert( key, entry );
     }
 
-
-    QTextLayout layout;
-    layout.setFont( font );
-    layout.setTextOption( textOption );
-    layout.setText( tmp );
-
-    layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
-    layout.endLayout();
+    const auto& layout = entry.layout;
+    const qreal textHeight = layout.textHeight;
 
     const qreal y0 = QFontMetricsF( font ).ascent();
 
@@ -234,12 +564,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( layout.boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, layout.glyphRuns, yBaseline,
         colors.textColor, static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor );
 }
@@ -261,3 +591,25 @@ void QskPlainTextRenderer::updateNodeColor(
         glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 }
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug,
+    const QskPlainTextRenderer::CacheStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "TextCache( hits: " << statistics.hits
+        << ", misses: " << statistics.misses
+        << ", hitRate: " << statistics.hitRate()
+        << ", evictions: " << statistics.evictions
+        << ", entries: " << statistics.count
+        << ", bytes: " << statistics.bytes << " )";
+
+    return debug;
+}
+
+#endif
@@ -7,13 +7,15 @@
 #define QSK_PLAIN_TEXT_RENDERER_H
 
 #include "QskNamespace.h"
+#include "QskTextOptions.h"
+
 #include <qnamespace.h>
+#include <qfont.h>
+#include <qstring.h>
+#include <qvector.h>
 
 class QskTextColors;
-class QskTextOptions;
 
-class QString;
-class QFont;
 class QRectF;
 class QSizeF;
 class QQuickItem;
@@ -37,6 +39,59 @@ namespace QskPlainTextRenderer
 
     QSK_EXPORT QRectF textRect( const QString&,
         const QFont&, const QskTextOptions&, const QSizeF& );
+
+    class TextRequest
+    {
+      public:
+        QString text;
+        QFont font;
+        QskTextOptions options;
+    };
+
+    /*
+        Measures the unconstrained sizes of texts from the global thread pool,
+        so that the following calls of textSize() are answered from the cache.
+        The function returns, when all texts have been measured.
+     */
+    QSK_EXPORT void precomputeTextSizes( const QVector< TextRequest >& );
+
+    /*
+        Measured text rectangles and shaped layouts are stored in a
+        cache, that is shared between size hint calculations and
+        building the glyph nodes. The cache is bounded by a memory budget
+        and evicts the least recently used entries.
+     */
+    class CacheStatistics
+    {
+      public:
+        inline qreal hitRate() const
+        {
+            const auto total = hits + misses;
+            return total ? qreal( hits ) / total : 0.0;
+        }
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        qint64 bytes = 0;
+        int count = 0;
+    };
+
+    QSK_EXPORT void setCacheMaxBytes( qint64 );
+    QSK_EXPORT qint64 cacheMaxBytes();
+
+    QSK_EXPORT CacheStatistics cacheStatistics();
+    QSK_EXPORT void resetCacheStatistics();
+
+    QSK_EXPORT void clearCache();
 }
 
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskPlainTextRenderer::CacheStatistics& );
+
+#endif
+
 #endif
@@ -7,8 +7,11 @@
 #include "QskVertex.h"
 #include "QskGradient.h"
 #include "QskRgbValue.h"
+#include "QskFillNodePrivate.h"
 
 #include <qpainterpath.h>
+#include <qpen.h>
+#include <qsgnode.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qtriangulatingstroker_p.h>
@@ -32,12 +35,189 @@ static inline bool qskIsPenVisible( const QPen& pen )
     return true;
 }
 
+static inline bool qskIsStrokeEqual( const QPen& pen1, const QPen& pen2 )
+{
+    // only the attributes, that have an effect on the geometry
+
+    if ( pen1.style() != pen2.style()
+        || pen1.widthF() != pen2.widthF()
+        || pen1.isCosmetic() != pen2.isCosmetic()
+        || pen1.capStyle() != pen2.capStyle()
+        || pen1.joinStyle() != pen2.joinStyle()
+        || pen1.miterLimit() != pen2.miterLimit() )
+    {
+        return false;
+    }
+
+    if ( pen1.style() != Qt::SolidLine )
+    {
+        if ( pen1.dashOffset() != pen2.dashOffset()
+            || pen1.dashPattern() != pen2.dashPattern() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static inline bool qskIsPolyline( const QPainterPath& path )
+{
+    if ( path.elementAt( 0 ).type != QPainterPath::MoveToElement )
+        return false;
+
+    for ( int i = 1; i < path.elementCount(); i++ )
+    {
+        if ( path.elementAt( i ).type != QPainterPath::LineToElement )
+            return false;
+    }
+
+    return true;
+}
+
+static inline bool qskIsAppended(
+    const QPainterPath& oldPath, const QPainterPath& path )
+{
+    const int count = oldPath.elementCount();
+
+    if ( count < 2 || path.elementCount() <= count )
+        return false;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( !( path.elementAt( i ) == oldPath.elementAt( i ) ) )
+            return false;
+    }
+
+    return qskIsPolyline( path );
+}
+
+static inline bool qskIsOpaque( const QSGNode* node )
+{
+    // the opacity of the items is applied by opacity nodes above
+
+    for ( auto n = node->parent(); n != nullptr; n = n->parent() )
+    {
+        if ( n->type() == QSGNode::OpacityNodeType )
+        {
+            if ( static_cast< const QSGOpacityNode* >( n )->opacity() < 1.0 )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static void qskStroke( const QPainterPath& path, const QTransform& transform,
+    const QPen& pen, QTriangulatingStroker& stroker )
+{
+    /*
+        Unfortunately QTriangulatingStroker does not offer on the fly
+        transformations - like with qTriangulate. TODO ...
+     */
+    const auto scaledPath = transform.map( path );
+
+    auto effectivePen = pen;
+
+    if ( !effectivePen.isCosmetic() )
+    {
+        const auto scaleFactor = qMin( transform.m11(), transform.m22() );
+        if ( scaleFactor != 1.0 )
+        {
+            effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
+            effectivePen.setCosmetic( false );
+        }
+    }
+
+    if ( pen.style() == Qt::SolidLine )
+    {
+        // clipRect, renderHint are ignored in QTriangulatingStroker::process
+        stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+    }
+    else
+    {
+        constexpr QRectF clipRect; // empty rect: no clipping
+
+        QDashedStrokeProcessor dashStroker;
+        dashStroker.process( qtVectorPathForPath( scaledPath ),
+            effectivePen, clipRect, {} );
+
+        const QVectorPath dashedVectorPath( dashStroker.points(),
+            dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+
+        stroker.process( dashedVectorPath, effectivePen, {}, {} );
+    }
+}
+
+static void qskUpdateGeometry( const float* vertices, int count,
+    const QColor& color, QSGGeometry& geometry )
+{
+    // 2 vertices for each point
+    geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+    geometry.allocate( count / 2 );
+
+    if ( color.isValid() )
+    {
+        const QskVertex::Color c( color );
+        auto points = geometry.vertexDataAsColoredPoint2D();
+
+        for ( int i = 0; i < geometry.vertexCount(); i++ )
+        {
+            const auto j = 2 * i;
+            points[i].set( vertices[j], vertices[j + 1], c.r, c.g, c.b, c.a );
+        }
+    }
+    else
+    {
+        memcpy( geometry.vertexData(), vertices, count * sizeof( float ) );
+    }
+}
+
+class QskStrokeNodePrivate final : public QskFillNodePrivate
+{
+  public:
+    QPainterPath path;
+    QTransform transform;
+    QPen pen;
+
+    bool appendOnly = false;
+
+    // the restroked segments of appending are drawn twice
+    bool hasOverlaps = false;
+
+    /*
+        The geometry is reallocated, when appending. So we need
+        to keep a copy of the vertices in appendOnly mode.
+     */
+    QVector< float > vertices;
+};
+
 QskStrokeNode::QskStrokeNode()
+    : QskFillNode( *new QskStrokeNodePrivate )
 {
 }
 
 QskStrokeNode::~QskStrokeNode() = default;
 
+void QskStrokeNode::setAppendOnly( bool on )
+{
+    Q_D( QskStrokeNode );
+
+    if ( on != d->appendOnly )
+    {
+        d->appendOnly = on;
+
+        // enforcing a complete update
+        d->path = QPainterPath();
+        d->vertices.clear();
+    }
+}
+
+bool QskStrokeNode::isAppendOnly() const
+{
+    return d_func()->appendOnly;
+}
+
 void QskStrokeNode::updatePath( const QPainterPath& path, const QPen& pen )
 {
     updatePath( path, QTransform(), pen );
@@ -46,12 +226,21 @@ void QskStrokeNode::updatePath( const QPainterPath& path, const QPen& pen )
 void QskStrokeNode::updatePath(
     const QPainterPath& path, const QTransform& transform, const QPen& pen )
 {
+    Q_D( QskStrokeNode );
+
     if ( path.isEmpty() || !qskIsPenVisible( pen ) )
     {
+        d->path = QPainterPath();
+        d->transform = QTransform();
+        d->vertices.clear();
+        d->hasOverlaps = false;
+
         resetGeometry();
         return;
     }
 
+    const bool wasColored = isGeometryColored();
+
     if ( auto qGradient = pen.brush().gradient() )
     {
         const auto r = transform.mapRect( path.boundingRect() );
@@ -64,73 +253,108 @@ void QskStrokeNode::updatePath(
     else
         setColoring( pen.color() );
 
-    if ( true ) // For the moment we always update the geometry. TODO ...
-    {
-        /*
-            Unfortunately QTriangulatingStroker does not offer on the fly
-            transformations - like with qTriangulate. TODO ...
-         */
-        const auto scaledPath = transform.map( path );
+    auto& geometry = *this->geometry();
 
-        auto effectivePen = pen;
+    const QColor color = isGeometryColored() ? pen.color() : QColor();
 
-        if ( !effectivePen.isCosmetic() )
-        {
-            const auto scaleFactor = qMin( transform.m11(), transform.m22() );
-            if ( scaleFactor != 1.0 )
-            {
-                effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
-                effectivePen.setCosmetic( false );
-            }
-        }
+    const bool isDirty = ( wasColored != isGeometryColored() )
+        || ( transform != d->transform )
+        || !qskIsStrokeEqual( pen, d->pen )
+        || ( color.isValid() && color != d->pen.color() );
 
-        QTriangulatingStroker stroker;
+    /*
+        Translucent nodes would blend the overlapping segments twice,
+        so appending is only done for opaque nodes.
+     */
+    const bool isOpaque = qskIsOpaque( this );
 
-        if ( pen.style() == Qt::SolidLine )
-        {
-            // clipRect, renderHint are ignored in QTriangulatingStroker::process
-            stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
-        }
-        else
-        {
-            constexpr QRectF clipRect; // empty rect: no clipping
+    if ( !isDirty && ( path == d->path ) && ( isOpaque || !d->hasOverlaps ) )
+        return;
 
-            QDashedStrokeProcessor dashStroker;
-            dashStroker.process( qtVectorPathForPath( scaledPath ),
-                effectivePen, clipRect, {} );
+    /*
+        Appending to a growing polyline: the previous geometry is kept
+        and only the new segments are stroked. To have the correct join
+        the last segment of the previous path is stroked again, what
+        would be visible for translucent pens or nodes.
 
-            const QVectorPath dashedVectorPath( dashStroker.points(),
-                dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+        The restroked segment also adds caps at the old end point,
+        that stick out of the joins - unless they are flat or
+        round caps together with round joins.
+     */
+    const bool hasHiddenCaps = ( pen.capStyle() == Qt::FlatCap )
+        || ( pen.capStyle() == Qt::RoundCap && pen.joinStyle() == Qt::RoundJoin );
 
-            stroker.process( dashedVectorPath, effectivePen, {}, {} );
-        }
+    const bool doAppend = !isDirty && d->appendOnly && hasHiddenCaps && isOpaque
+        && ( pen.style() == Qt::SolidLine )
+        && ( pen.brush().gradient() == nullptr )
+        && ( pen.color().alpha() == 255 )
+        && ( geometry.vertexCount() == d->vertices.count() / 2 )
+        && qskIsAppended( d->path, path );
 
-        auto& geometry = *this->geometry();
+    QTriangulatingStroker stroker;
 
-        // 2 vertices for each point
-        geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-        geometry.allocate( stroker.vertexCount() / 2 );
+    if ( doAppend )
+    {
+        const int count = d->path.elementCount();
 
-        if ( isGeometryColored() )
-        {
-            const QskVertex::Color c( pen.color() );
+        QPainterPath tail;
+        tail.moveTo( path.elementAt( count - 2 ) );
 
-            const auto v = stroker.vertices();
-            auto points = geometry.vertexDataAsColoredPoint2D();
+        for ( int i = count - 1; i < path.elementCount(); i++ )
+            tail.lineTo( path.elementAt( i ) );
 
-            for ( int i = 0; i < geometry.vertexCount(); i++ )
+        qskStroke( tail, transform, pen, stroker );
+
+        if ( stroker.vertexCount() >= 2 )
+        {
+            auto& vertices = d->vertices;
+
+            if ( !vertices.isEmpty() )
             {
-                const auto j = 2 * i;
-                points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
+                // degenerated triangles to connect the strips
+
+                const auto v = stroker.vertices();
+
+                const float x = vertices[ vertices.count() - 2 ];
+                const float y = vertices[ vertices.count() - 1 ];
+
+                vertices << x << y << v[0] << v[1];
             }
+
+            const auto from = vertices.count();
+            vertices.resize( from + stroker.vertexCount() );
+
+            memcpy( vertices.data() + from, stroker.vertices(),
+                stroker.vertexCount() * sizeof( float ) );
         }
-        else
+
+        qskUpdateGeometry( d->vertices.constData(),
+            d->vertices.count(), color, geometry );
+
+        d->hasOverlaps = true;
+    }
+    else
+    {
+        qskStroke( path, transform, pen, stroker );
+
+        if ( d->appendOnly )
         {
-            memcpy( geometry.vertexData(), stroker.vertices(),
+            d->vertices.resize( stroker.vertexCount() );
+
+            memcpy( d->vertices.data(), stroker.vertices(),
                 stroker.vertexCount() * sizeof( float ) );
         }
 
-        geometry.markVertexDataDirty();
-        markDirty( QSGNode::DirtyGeometry );
+        qskUpdateGeometry( stroker.vertices(),
+            stroker.vertexCount(), color, geometry );
+
+        d->hasOverlaps = false;
     }
+
+    d->path = path;
+    d->transform = transform;
+    d->pen = pen;
+
+    geometry.markVertexDataDirty();
+    markDirty( QSGNode::DirtyGeometry );
 }
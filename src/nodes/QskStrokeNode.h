@@ -13,6 +13,8 @@ class QPen;
 class QPainterPath;
 class QPolygonF;
 
+class QskStrokeNodePrivate;
+
 class QSK_EXPORT QskStrokeNode : public QskFillNode
 {
     using Inherited = QskFillNode;
@@ -23,6 +25,25 @@ class QSK_EXPORT QskStrokeNode : public QskFillNode
 
     void updatePath( const QPainterPath&, const QPen& );
     void updatePath( const QPainterPath&, const QTransform&, const QPen& );
+
+    /*
+        In appendOnly mode the path is expected to be a polyline, that
+        grows at its end - like the curve of a live plot. When the previous
+        path is the beginning of the new one, only the new segments are
+        stroked and appended to the geometry.
+
+        This mode keeps a copy of the vertices and is only applied for
+        solid opaque pens with flat caps or with round caps and joins.
+        As the join to the previous segments is drawn twice, it is not
+        applied, when an opacity node above is translucent. The geometry
+        is stroked completely again, when such a node is updated.
+        The default setting is false.
+     */
+    void setAppendOnly( bool );
+    bool isAppendOnly() const;
+
+  private:
+    Q_DECLARE_PRIVATE( QskStrokeNode )
 };
 
 #endif
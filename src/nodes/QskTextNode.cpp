@@ -7,14 +7,14 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 #include "QskTextRenderer.h"
+#include "QskPlainTextRenderer.h"
 
 #include <qfont.h>
 #include <qstring.h>
 
-static inline QskHashValue qskHash(
+static inline QskHashValue qskGeometryHash(
     const QString& text, const QSizeF& size, const QFont& font,
-    const QskTextOptions& options, const QskTextColors& colors,
-    Qt::Alignment alignment, Qsk::TextStyle textStyle )
+    const QskTextOptions& options, Qt::Alignment alignment )
 {
     QskHashValue hash = 11000;
 
@@ -22,15 +22,25 @@ static inline QskHashValue qskHash(
     hash = qHash( font, hash );
     hash = options.hash( hash );
     hash = qHash( alignment, hash );
+    hash = qHashBits( &size, sizeof( QSizeF ), hash );
+
+    return hash;
+}
+
+static inline QskHashValue qskColorHash(
+    const QskTextColors& colors, Qsk::TextStyle textStyle )
+{
+    QskHashValue hash = 11001;
+
     hash = qHash( textStyle, hash );
     hash = colors.hash( hash );
-    hash = qHashBits( &size, sizeof( QSizeF ), hash );
 
     return hash;
 }
 
 QskTextNode::QskTextNode()
-    : m_hash( 0 )
+    : m_geometryHash( 0 )
+    , m_colorHash( 0 )
 {
 }
 
@@ -49,21 +59,38 @@ void QskTextNode::setTextData(
     if ( matrix != this->matrix() ) // avoid setting DirtyMatrix accidently
         setMatrix( matrix );
 
-    const auto hash = qskHash( text, rect.size(), font,
-        options, colors, alignment, textStyle );
+    const auto geometryHash = qskGeometryHash(
+        text, rect.size(), font, options, alignment );
 
-    if ( hash != m_hash )
+    const auto colorHash = qskColorHash( colors, textStyle );
+
+    if ( geometryHash == m_geometryHash )
     {
-        m_hash = hash;
+        if ( colorHash == m_colorHash )
+            return;
+
+        if ( options.format() == QskTextOptions::PlainText )
+        {
+            /*
+                Only the colors have changed ( f.e. during skin transitions ):
+                the glyph nodes can be recolored without a new layout.
+                For rich text the colors might be part of the markup,
+                so we can't do the same.
+             */
+            m_colorHash = colorHash;
 
-        const QRectF textRect( 0, 0, rect.width(), rect.height() );
+            QskPlainTextRenderer::updateNodeColor( this,
+                colors.textColor, textStyle, colors.styleColor );
 
-        /*
-            In case of having color changes only we would could
-            go a faster update path: see QskPlainTextRenderer::updateNodeColor.
-            TODO ...
-         */
-        QskTextRenderer::updateNode( text, font, options, textStyle,
-            colors, alignment, textRect, item, this );
+            return;
+        }
     }
+
+    m_geometryHash = geometryHash;
+    m_colorHash = colorHash;
+
+    const QRectF textRect( 0, 0, rect.width(), rect.height() );
+
+    QskTextRenderer::updateNode( text, font, options, textStyle,
+        colors, alignment, textRect, item, this );
 }
@@ -29,7 +29,9 @@ class QSK_EXPORT QskTextNode : public QSGTransformNode
         Qt::Alignment, Qsk::TextStyle );
 
   private:
-    QskHashValue m_hash;
+    // changes of the colors only do not require a new layout
+    QskHashValue m_geometryHash;
+    QskHashValue m_colorHash;
 };
 
 #endif
@@ -0,0 +1,329 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+QskTextureCache::Content::~Content()
+{
+}
+
+bool QskTextureCache::Key::operator==( const Key& other ) const
+{
+    if ( ( hash != other.hash ) || ( size != other.size )
+        || ( textureType != other.textureType )
+        || !qFuzzyCompare( devicePixelRatio, other.devicePixelRatio ) )
+    {
+        return false;
+    }
+
+    // keys without content never match
+
+    return content && other.content
+        && ( ( content == other.content ) || content->isEqual( *other.content ) );
+}
+
+namespace QskTextureCache
+{
+    // found by ADL, when being used as key of a QHash
+    static inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 ) noexcept
+    {
+        seed = ::qHash( key.hash, seed );
+        seed = ::qHash( key.size.width(), seed );
+        seed = ::qHash( key.size.height(), seed );
+        return ::qHash( key.textureType, seed );
+    }
+}
+
+namespace
+{
+    using Key = QskTextureCache::Key;
+
+    class Entry
+    {
+      public:
+        QSGTexture* texture = nullptr;
+
+        int refCount = 0;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;
+    };
+
+    class WindowCache
+    {
+      public:
+        ~WindowCache()
+        {
+            for ( const auto& entry : std::as_const( m_entries ) )
+                delete entry.texture;
+        }
+
+        QSGTexture* acquire( const Key& key )
+        {
+            auto it = m_entries.find( key );
+            if ( it == m_entries.end() )
+            {
+                statistics.misses++;
+                return nullptr;
+            }
+
+            statistics.hits++;
+
+            it->refCount++;
+            it->lastUsed = ++m_clock;
+
+            return it->texture;
+        }
+
+        QSGTexture* insert( const Key& key, QSGTexture* texture, qint64 maxBytes )
+        {
+            if ( auto cachedTexture = acquire( key ) )
+            {
+                // should never happen as we always try to acquire first
+                if ( cachedTexture != texture )
+                    delete texture;
+
+                return cachedTexture;
+            }
+
+            Entry entry;
+            entry.texture = texture;
+            entry.refCount = 1;
+            entry.bytes = qint64( key.size.width() ) * key.size.height() * 4;
+            entry.lastUsed = ++m_clock;
+
+            m_entries.insert( key, entry );
+            m_keys.insert( texture, key );
+
+            statistics.bytesResident += entry.bytes;
+            statistics.textureCount++;
+
+            evict( maxBytes );
+
+            return texture;
+        }
+
+        bool release( const QSGTexture* texture, qint64 maxBytes )
+        {
+            auto it = m_keys.constFind( texture );
+            if ( it == m_keys.constEnd() )
+                return false;
+
+            auto& entry = m_entries[ it.value() ];
+            if ( --entry.refCount <= 0 )
+            {
+                entry.refCount = 0;
+                evict( maxBytes );
+            }
+
+            return true;
+        }
+
+        void evict( qint64 maxBytes )
+        {
+            while ( statistics.bytesResident > maxBytes )
+            {
+                // least recently used texture, that is not in use
+
+                auto candidate = m_entries.end();
+
+                for ( auto it = m_entries.begin(); it != m_entries.end(); ++it )
+                {
+                    if ( it->refCount == 0 )
+                    {
+                        if ( candidate == m_entries.end()
+                            || it->lastUsed < candidate->lastUsed )
+                        {
+                            candidate = it;
+                        }
+                    }
+                }
+
+                if ( candidate == m_entries.end() )
+                    return;
+
+                statistics.bytesResident -= candidate->bytes;
+                statistics.textureCount--;
+                statistics.evictions++;
+
+                m_keys.remove( candidate->texture );
+                delete candidate->texture;
+
+                m_entries.erase( candidate );
+            }
+        }
+
+        QskTextureCache::Statistics statistics;
+
+      private:
+        QHash< Key, Entry > m_entries;
+        QHash< const QSGTexture*, Key > m_keys;
+
+        quint64 m_clock = 0;
+    };
+
+    class CacheMap
+    {
+      public:
+        ~CacheMap()
+        {
+            qDeleteAll( m_caches );
+        }
+
+        WindowCache* cache( const QQuickWindow* window, bool& created )
+        {
+            created = false;
+
+            auto it = m_caches.constFind( window );
+            if ( it != m_caches.constEnd() )
+                return it.value();
+
+            auto cache = new WindowCache();
+            m_caches.insert( window, cache );
+
+            created = true;
+            return cache;
+        }
+
+        void removeCache( const QQuickWindow* window )
+        {
+            delete m_caches.take( window );
+        }
+
+        WindowCache* findCache( const QQuickWindow* window ) const
+        {
+            return m_caches.value( window, nullptr );
+        }
+
+        bool release( const QSGTexture* texture, qint64 maxBytes )
+        {
+            for ( auto cache : std::as_const( m_caches ) )
+            {
+                if ( cache->release( texture, maxBytes ) )
+                    return true;
+            }
+
+            return false;
+        }
+
+        QMutex mutex;
+        qint64 maxBytes = 32 * 1024 * 1024;
+
+      private:
+        QHash< const QQuickWindow*, WindowCache* > m_caches;
+    };
+}
+
+Q_GLOBAL_STATIC( CacheMap, qskCacheMap )
+
+static void qskRemoveCache( const QQuickWindow* window )
+{
+    if ( !qskCacheMap.isDestroyed() )
+    {
+        QMutexLocker locker( &qskCacheMap->mutex );
+        qskCacheMap->removeCache( window );
+    }
+}
+
+static WindowCache* qskWindowCache( QQuickWindow* window )
+{
+    // qskCacheMap->mutex has to be locked
+
+    bool created;
+    auto cache = qskCacheMap->cache( window, created );
+
+    if ( created )
+    {
+        /*
+            The textures have to be deleted, while the
+            scene graph is still alive: so we can't wait
+            for the window being destroyed.
+         */
+        QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+            window, [ window ] { qskRemoveCache( window ); },
+            Qt::DirectConnection );
+
+        QObject::connect( window, &QObject::destroyed,
+            [ window ] { qskRemoveCache( window ); } );
+    }
+
+    return cache;
+}
+
+void QskTextureCache::setMaxBytes( qint64 maxBytes )
+{
+    QMutexLocker locker( &qskCacheMap->mutex );
+    qskCacheMap->maxBytes = qMax( maxBytes, qint64( 0 ) );
+}
+
+qint64 QskTextureCache::maxBytes()
+{
+    QMutexLocker locker( &qskCacheMap->mutex );
+    return qskCacheMap->maxBytes;
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics( const QQuickWindow* window )
+{
+    QMutexLocker locker( &qskCacheMap->mutex );
+
+    if ( auto cache = qskCacheMap->findCache( window ) )
+        return cache->statistics;
+
+    return Statistics();
+}
+
+QSGTexture* QskTextureCache::acquire( QQuickWindow* window, const Key& key )
+{
+    if ( window == nullptr )
+        return nullptr;
+
+    QMutexLocker locker( &qskCacheMap->mutex );
+    return qskWindowCache( window )->acquire( key );
+}
+
+QSGTexture* QskTextureCache::insert(
+    QQuickWindow* window, const Key& key, QSGTexture* texture )
+{
+    if ( window == nullptr || texture == nullptr )
+        return texture;
+
+    QMutexLocker locker( &qskCacheMap->mutex );
+
+    auto cache = qskWindowCache( window );
+    return cache->insert( key, texture, qskCacheMap->maxBytes );
+}
+
+void QskTextureCache::release( QSGTexture* texture )
+{
+    if ( texture == nullptr )
+        return;
+
+    QMutexLocker locker( &qskCacheMap->mutex );
+    qskCacheMap->release( texture, qskCacheMap->maxBytes );
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskTextureCache::Statistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "TextureCache( hits: " << statistics.hits
+        << ", misses: " << statistics.misses
+        << ", evictions: " << statistics.evictions
+        << ", textures: " << statistics.textureCount
+        << ", bytes: " << statistics.bytesResident << " )";
+
+    return debug;
+}
+
+#endif
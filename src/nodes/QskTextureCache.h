@@ -0,0 +1,89 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qsize.h>
+#include <memory>
+
+class QSGTexture;
+class QQuickWindow;
+
+/*
+    A per window cache for textures, that have been created from
+    painted content. Nodes with identical content ( same content and texture
+    size ) share the same texture, so that the content is rasterized once.
+
+    Textures are reference counted. Unreferenced textures are kept
+    for reuse as long as the byte budget is not exceeded and get evicted
+    in least recently used order.
+ */
+namespace QskTextureCache
+{
+    class Statistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        qint64 bytesResident = 0;
+        int textureCount = 0;
+    };
+
+    /*
+        A description of the painted content, that can be compared
+        with the content of other nodes. As the hash value is only used
+        for finding the candidates, a collision never results in
+        sharing a texture with different content.
+     */
+    class QSK_EXPORT Content
+    {
+      public:
+        virtual ~Content();
+        virtual bool isEqual( const Content& ) const = 0;
+    };
+
+    class QSK_EXPORT Key
+    {
+      public:
+        bool operator==( const Key& ) const;
+        inline bool operator!=( const Key& other ) const { return !( *this == other ); }
+
+        QskHashValue hash = 0;
+        QSize size;
+
+        // how the texture has been created: device pixel ratio, texture type
+        qreal devicePixelRatio = 1.0;
+        int textureType = 0;
+
+        std::shared_ptr< const Content > content;
+    };
+
+    QSK_EXPORT void setMaxBytes( qint64 );
+    QSK_EXPORT qint64 maxBytes();
+
+    QSK_EXPORT Statistics statistics( const QQuickWindow* );
+
+    // increases the reference counter of a matching texture
+    QSK_EXPORT QSGTexture* acquire( QQuickWindow*, const Key& );
+
+    // takes ownership, the reference counter of the texture is 1
+    QSK_EXPORT QSGTexture* insert( QQuickWindow*, const Key&, QSGTexture* );
+
+    QSK_EXPORT void release( QSGTexture* );
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskTextureCache::Statistics& );
+
+#endif
+
+#endif
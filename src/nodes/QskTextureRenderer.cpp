@@ -10,6 +10,7 @@
 #include <qopenglframebufferobject.h>
 #include <qopenglpaintdevice.h>
 
+#include <qatomic.h>
 #include <qimage.h>
 #include <qpainter.h>
 
@@ -236,3 +237,34 @@ QSGTexture* QskTextureRenderer::createPaintedTexture(
         return qskCreateTextureRaster( window, size, helper );
     }
 }
+
+/*
+    The limit is set from the GUI thread, but read when creating
+    textures in the scene graph thread. So we pack width/height into
+    one atomic value to avoid reading a half updated limit.
+ */
+static QAtomicInteger< quint64 > qskAtlasSizeLimit( ( Q_UINT64_C( 128 ) << 32 ) | 128 );
+
+void QskTextureRenderer::setAtlasSizeLimit( const QSize& size )
+{
+    const auto w = static_cast< quint32 >( qMax( size.width(), 0 ) );
+    const auto h = static_cast< quint32 >( qMax( size.height(), 0 ) );
+
+    qskAtlasSizeLimit.storeRelaxed( ( quint64( w ) << 32 ) | h );
+}
+
+QSize QskTextureRenderer::atlasSizeLimit()
+{
+    const auto value = qskAtlasSizeLimit.loadRelaxed();
+    return QSize( static_cast< int >( value >> 32 ),
+        static_cast< int >( value & 0xffffffff ) );
+}
+
+bool QskTextureRenderer::isAtlasCandidate( const QSize& size )
+{
+    const auto limit = atlasSizeLimit();
+
+    return !size.isEmpty() && !limit.isEmpty()
+        && ( size.width() <= limit.width() )
+        && ( size.height() <= limit.height() );
+}
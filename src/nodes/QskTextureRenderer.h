@@ -37,6 +37,17 @@ namespace QskTextureRenderer
 
     QSK_EXPORT QSGTexture* createPaintedTexture(
         QQuickWindow* window, const QSize& size, PaintHelper* helper );
+
+    /*
+        Small textures can be rasterized into the atlas of the
+        scene graph, so that nodes using them can be batched.
+        The limit is in device pixels and is compared against
+        the size of the texture. An empty size disables using the atlas.
+     */
+    QSK_EXPORT void setAtlasSizeLimit( const QSize& );
+    QSK_EXPORT QSize atlasSizeLimit();
+
+    QSK_EXPORT bool isAtlasCandidate( const QSize& );
 }
 
 #endif
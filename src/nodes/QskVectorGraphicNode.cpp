@@ -0,0 +1,351 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskVectorGraphicNode.h"
+#include "QskColorFilter.h"
+#include "QskGradient.h"
+#include "QskGraphic.h"
+#include "QskPainterCommand.h"
+#include "QskSGNode.h"
+#include "QskShapeNode.h"
+#include "QskStrokeNode.h"
+
+#include <qline.h>
+#include <qmatrix4x4.h>
+#include <qtransform.h>
+
+namespace
+{
+    enum Role : quint8
+    {
+        FillRole,
+        StrokeRole
+    };
+
+    inline bool isSupportedBrush( const QBrush& brush )
+    {
+        switch( brush.style() )
+        {
+            case Qt::NoBrush:
+            case Qt::SolidPattern:
+            case Qt::LinearGradientPattern:
+            case Qt::RadialGradientPattern:
+            case Qt::ConicalGradientPattern:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    inline QColor effectiveColor( QColor color, qreal opacity )
+    {
+        if ( opacity < 1.0 )
+            color.setAlphaF( color.alphaF() * opacity );
+
+        return color;
+    }
+
+    template< typename Node >
+    Node* nextNode( QSGNode* parentNode, QSGNode*& cursor, quint8 role )
+    {
+        if ( cursor && QskSGNode::nodeRole( cursor ) == role )
+        {
+            auto node = cursor;
+            cursor = cursor->nextSibling();
+
+            return static_cast< Node* >( node );
+        }
+
+        auto node = QskSGNode::createNode< Node >( role );
+
+        if ( cursor )
+            parentNode->insertChildNodeBefore( node, cursor );
+        else
+            parentNode->appendChildNode( node );
+
+        return node;
+    }
+}
+
+static QskGradient qskEffectiveGradient( const QGradient& qGradient,
+    const QTransform& transform, qreal opacity )
+{
+    /*
+        QskGradient( QGradient ) maps ObjectMode/ObjectBoundingMode
+        to StretchToSize and LogicalMode to NoStretch. Logical
+        coordinates refer to the path and have to be mapped
+        like the vertices.
+     */
+    QskGradient gradient( qGradient );
+
+    if ( gradient.stretchMode() == QskGradient::NoStretch )
+    {
+        switch( gradient.type() )
+        {
+            case QskGradient::Linear:
+            {
+                const auto dir = gradient.linearDirection();
+
+                gradient.setLinearDirection( QskLinearDirection(
+                    transform.map( dir.start() ), transform.map( dir.stop() ) ) );
+
+                break;
+            }
+            case QskGradient::Radial:
+            {
+                auto dir = gradient.radialDirection();
+
+                const auto center = dir.center();
+
+                const QLineF lineX( center, center + QPointF( dir.radiusX(), 0.0 ) );
+                const QLineF lineY( center, center + QPointF( 0.0, dir.radiusY() ) );
+
+                dir.setCenter( transform.map( center ) );
+                dir.setRadiusX( transform.map( lineX ).length() );
+                dir.setRadiusY( transform.map( lineY ).length() );
+
+                gradient.setRadialDirection( dir );
+                break;
+            }
+            case QskGradient::Conic:
+            {
+                auto dir = gradient.conicDirection();
+                dir.setCenter( transform.map( dir.center() ) );
+
+                gradient.setConicDirection( dir );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    if ( opacity < 1.0 )
+    {
+        auto stops = gradient.stops();
+        for ( auto& stop : stops )
+            stop.setColor( effectiveColor( stop.color(), opacity ) );
+
+        gradient.setStops( stops );
+    }
+
+    return gradient;
+}
+
+static QBrush qskEffectiveBrush( const QBrush& brush, qreal opacity )
+{
+    if ( opacity >= 1.0 )
+        return brush;
+
+    if ( auto qGradient = brush.gradient() )
+    {
+        auto stops = qGradient->stops();
+        for ( auto& stop : stops )
+            stop.second = effectiveColor( stop.second, opacity );
+
+        QGradient gradient = *qGradient;
+        gradient.setStops( stops );
+
+        return QBrush( gradient );
+    }
+
+    return QBrush( effectiveColor( brush.color(), opacity ) );
+}
+
+static inline QskHashValue qskGraphicHash(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    QskHashValue hash = 13000;
+
+    const auto& substitutions = colorFilter.substitutions();
+    if ( substitutions.size() > 0 )
+    {
+        hash = qHashBits( substitutions.constData(),
+            substitutions.size() * sizeof( substitutions[ 0 ] ), hash );
+    }
+
+    return graphic.hash( hash );
+}
+
+QskVectorGraphicNode::QskVectorGraphicNode()
+{
+}
+
+QskVectorGraphicNode::~QskVectorGraphicNode()
+{
+}
+
+bool QskVectorGraphicNode::isTessellatable( const QskGraphic& graphic )
+{
+    if ( graphic.isEmpty() || ( graphic.commandTypes() & QskGraphic::RasterData ) )
+        return false;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        if ( command.type() != QskPainterCommand::State )
+            continue;
+
+        const auto data = command.stateData();
+
+        if ( data->flags & QPaintEngine::DirtyBrush )
+        {
+            if ( !isSupportedBrush( data->brush ) )
+                return false;
+        }
+
+        if ( data->flags & QPaintEngine::DirtyPen )
+        {
+            if ( !isSupportedBrush( data->pen.brush() ) )
+                return false;
+        }
+
+        if ( ( data->flags & QPaintEngine::DirtyClipEnabled ) && data->isClipEnabled )
+            return false;
+
+        if ( data->flags & ( QPaintEngine::DirtyClipPath | QPaintEngine::DirtyClipRegion ) )
+        {
+            if ( data->clipOperation != Qt::NoClip )
+                return false;
+        }
+
+        if ( data->flags & QPaintEngine::DirtyCompositionMode )
+        {
+            if ( data->compositionMode != QPainter::CompositionMode_SourceOver )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void QskVectorGraphicNode::setGraphic( const QskGraphic& graphic,
+    const QskColorFilter& colorFilter, const QRectF& rect, Qt::Orientations mirrored )
+{
+    if ( rect.isEmpty() || graphic.isEmpty() )
+    {
+        m_hash = 0;
+        m_size = QSizeF();
+
+        removeAllChildNodes();
+        return;
+    }
+
+    /*
+        The geometry is calculated in local coordinates, so that
+        moving the graphic is a matter of updating the matrix only.
+     */
+    const auto hash = qskGraphicHash( graphic, colorFilter );
+    if ( hash != m_hash || rect.size() != m_size )
+    {
+        m_hash = hash;
+        m_size = rect.size();
+
+        updateGeometry( graphic, colorFilter, m_size );
+    }
+
+    QTransform transform;
+    transform.translate( rect.x(), rect.y() );
+
+    if ( mirrored & Qt::Horizontal )
+    {
+        transform.translate( rect.width(), 0.0 );
+        transform.scale( -1.0, 1.0 );
+    }
+
+    if ( mirrored & Qt::Vertical )
+    {
+        transform.translate( 0.0, rect.height() );
+        transform.scale( 1.0, -1.0 );
+    }
+
+    const QMatrix4x4 m( transform );
+    if ( m != matrix() )
+        setMatrix( m );
+}
+
+void QskVectorGraphicNode::updateGeometry( const QskGraphic& graphic,
+    const QskColorFilter& colorFilter, const QSizeF& size )
+{
+    const auto renderTransform = graphic.renderTransform(
+        QRectF( 0.0, 0.0, size.width(), size.height() ) );
+
+    const bool scalePens = !graphic.testRenderHint( QskGraphic::RenderPensUnscaled );
+
+    // the initial state of a QPainter
+    QPen pen;
+    QBrush brush;
+    QTransform stateTransform;
+    qreal opacity = 1.0;
+
+    QSGNode* cursor = firstChild();
+
+    for ( const auto& command : graphic.commands() )
+    {
+        switch( command.type() )
+        {
+            case QskPainterCommand::State:
+            {
+                const auto data = command.stateData();
+
+                if ( data->flags & QPaintEngine::DirtyPen )
+                    pen = colorFilter.substituted( data->pen );
+
+                if ( data->flags & QPaintEngine::DirtyBrush )
+                    brush = colorFilter.substituted( data->brush );
+
+                if ( data->flags & QPaintEngine::DirtyTransform )
+                    stateTransform = data->transform;
+
+                if ( data->flags & QPaintEngine::DirtyOpacity )
+                    opacity = data->opacity;
+
+                break;
+            }
+            case QskPainterCommand::Path:
+            {
+                const auto& path = *command.path();
+                const auto transform = stateTransform * renderTransform;
+
+                if ( brush.style() != Qt::NoBrush )
+                {
+                    QskGradient gradient;
+
+                    if ( auto qGradient = brush.gradient() )
+                        gradient = qskEffectiveGradient( *qGradient, transform, opacity );
+                    else
+                        gradient = effectiveColor( brush.color(), opacity );
+
+                    const auto rect = transform.mapRect( path.boundingRect() );
+
+                    auto fillNode = nextNode< QskShapeNode >( this, cursor, FillRole );
+                    fillNode->updatePath( path, transform, rect, gradient );
+                }
+
+                if ( pen.style() != Qt::NoPen )
+                {
+                    auto effectivePen = pen;
+                    effectivePen.setBrush( qskEffectiveBrush( pen.brush(), opacity ) );
+
+                    if ( !scalePens )
+                        effectivePen.setCosmetic( true );
+
+                    auto strokeNode = nextNode< QskStrokeNode >( this, cursor, StrokeRole );
+                    strokeNode->updatePath( path, transform, effectivePen );
+                }
+
+                break;
+            }
+            default:
+            {
+                // raster data is not supported
+                break;
+            }
+        }
+    }
+
+    if ( cursor )
+        QskSGNode::removeAllChildNodesFrom( this, cursor );
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_VECTOR_GRAPHIC_NODE_H
+#define QSK_VECTOR_GRAPHIC_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskGraphic;
+class QskColorFilter;
+
+/*
+    QskVectorGraphicNode converts the paths of a QskGraphic into
+    triangles instead of rasterizing them into a texture. The graphic
+    can be scaled without being blurred and the nodes can be batched
+    with other geometry nodes.
+
+    Only graphics without raster data, clipping or special composition
+    modes can be tessellated: see isTessellatable().
+ */
+class QSK_EXPORT QskVectorGraphicNode : public QSGTransformNode
+{
+  public:
+    QskVectorGraphicNode();
+    ~QskVectorGraphicNode() override;
+
+    void setGraphic( const QskGraphic&, const QskColorFilter&,
+        const QRectF&, Qt::Orientations mirrored = Qt::Orientations() );
+
+    static bool isTessellatable( const QskGraphic& );
+
+  private:
+    void updateGeometry( const QskGraphic&, const QskColorFilter&, const QSizeF& );
+
+    QskHashValue m_hash = 0;
+    QSizeF m_size;
+};
+
+#endif
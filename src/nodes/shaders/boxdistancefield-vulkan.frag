@@ -0,0 +1,56 @@
+#version 440
+
+layout( location = 0 ) in vec2 coord;
+layout( location = 0 ) out vec4 fragColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 outerRadii;
+    vec4 innerRadii;
+    vec4 innerRect;
+    vec4 fillStartColor;
+    vec4 fillStopColor;
+    vec4 borderColor;
+    vec4 gradient;
+    vec2 halfSize;
+    float opacity;
+} ubuf;
+
+float effectiveRadius( in vec4 radii, in vec2 point )
+{
+    // radii: top left, top right, bottom left, bottom right
+    if ( point.y < 0.0 )
+        return ( point.x < 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.x < 0.0 ) ? radii.z : radii.w;
+}
+
+float roundedBox( in vec2 point, in vec2 halfSize, in vec4 radii )
+{
+    float r = effectiveRadius( radii, point );
+
+    vec2 d = abs( point ) - halfSize + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    float outerDistance = roundedBox( coord, ubuf.halfSize, ubuf.outerRadii );
+    float innerDistance = roundedBox( coord - ubuf.innerRect.xy,
+        ubuf.innerRect.zw, ubuf.innerRadii );
+
+    float aa = max( 0.5 * fwidth( outerDistance ), 0.0001 );
+
+    float outerCoverage = 1.0 - smoothstep( -aa, aa, outerDistance );
+    float innerCoverage = min( 1.0 - smoothstep( -aa, aa, innerDistance ), outerCoverage );
+
+    float t = clamp( dot( coord - ubuf.gradient.xy, ubuf.gradient.zw ), 0.0, 1.0 );
+    vec4 fillColor = mix( ubuf.fillStartColor, ubuf.fillStopColor, t );
+
+    // colors are premultiplied
+    vec4 col = fillColor * innerCoverage
+        + ubuf.borderColor * ( outerCoverage - innerCoverage );
+
+    fragColor = col * ubuf.opacity;
+}
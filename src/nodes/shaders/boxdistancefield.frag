@@ -0,0 +1,52 @@
+#ifdef GL_ES
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+uniform lowp float opacity;
+uniform highp vec2 halfSize;
+uniform highp vec4 outerRadii;
+uniform highp vec4 innerRadii;
+uniform highp vec4 innerRect;
+uniform lowp vec4 fillStartColor;
+uniform lowp vec4 fillStopColor;
+uniform lowp vec4 borderColor;
+uniform highp vec4 gradient;
+
+varying highp vec2 coord;
+
+highp float effectiveRadius( in highp vec4 radii, in highp vec2 point )
+{
+    // radii: top left, top right, bottom left, bottom right
+    if ( point.y < 0.0 )
+        return ( point.x < 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.x < 0.0 ) ? radii.z : radii.w;
+}
+
+highp float roundedBox( in highp vec2 point, in highp vec2 size, in highp vec4 radii )
+{
+    highp float r = effectiveRadius( radii, point );
+
+    highp vec2 d = abs( point ) - size + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    highp float outerDistance = roundedBox( coord, halfSize, outerRadii );
+    highp float innerDistance = roundedBox( coord - innerRect.xy, innerRect.zw, innerRadii );
+
+    highp float aa = max( 0.5 * fwidth( outerDistance ), 0.0001 );
+
+    lowp float outerCoverage = 1.0 - smoothstep( -aa, aa, outerDistance );
+    lowp float innerCoverage = min( 1.0 - smoothstep( -aa, aa, innerDistance ), outerCoverage );
+
+    highp float t = clamp( dot( coord - gradient.xy, gradient.zw ), 0.0, 1.0 );
+    lowp vec4 fillColor = mix( fillStartColor, fillStopColor, t );
+
+    // colors are premultiplied
+    lowp vec4 col = fillColor * innerCoverage
+        + borderColor * ( outerCoverage - innerCoverage );
+
+    gl_FragColor = col * opacity;
+}
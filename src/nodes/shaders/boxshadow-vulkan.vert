@@ -2,16 +2,18 @@
 
 layout( location = 0 ) in vec4 in_vertex;
 layout( location = 1 ) in vec2 in_coord;
+layout( location = 2 ) in vec4 in_color;
+layout( location = 3 ) in vec4 in_radius;
+layout( location = 4 ) in vec3 in_parameters;
 
 layout( location = 0 ) out vec2 coord;
+layout( location = 1 ) out vec4 color;
+layout( location = 2 ) out vec4 radius;
+layout( location = 3 ) out vec3 parameters;
 
 layout( std140, binding = 0 ) uniform buf
 {
     mat4 matrix;
-    vec4 color;
-    vec4 radius;
-    vec2 aspectRatio;
-    float blurExtent;
     float opacity;
 } ubuf;
 
@@ -20,5 +22,9 @@ out gl_PerVertex { vec4 gl_Position; };
 void main()
 {
     coord = in_coord;
+    color = in_color * ubuf.opacity;
+    radius = in_radius;
+    parameters = in_parameters;
+
     gl_Position = ubuf.matrix * in_vertex;
 }
@@ -1,10 +1,7 @@
-uniform lowp float opacity;
-uniform lowp float blurExtent;
-uniform lowp vec4 radius;
-uniform lowp vec4 color;
-uniform lowp vec2 aspectRatio;
-
 varying lowp vec2 coord;
+varying lowp vec4 color;
+varying lowp vec4 radius;
+varying mediump vec3 parameters; // aspectRatio, blurExtent
 
 lowp float effectiveRadius( in lowp vec4 radii, in lowp vec2 point )
 {
@@ -16,7 +13,8 @@ lowp float effectiveRadius( in lowp vec4 radii, in lowp vec2 point )
 
 void main()
 {
-    lowp vec4 col = vec4(0.0);
+    lowp vec2 aspectRatio = parameters.xy;
+    lowp float blurExtent = parameters.z;
 
     lowp float e2 = 0.5 * blurExtent;
     lowp float r = 2.0 * effectiveRadius( radius, coord );
@@ -30,7 +28,5 @@ void main()
     lowp float shadow = l - r;
 
     lowp float v = smoothstep( -e2, e2, shadow );
-    col = mix( color, vec4(0.0), v ) * opacity;
-
-    gl_FragColor = col; 
+    gl_FragColor = mix( color, vec4(0.0), v );
 }
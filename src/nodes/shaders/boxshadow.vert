@@ -1,13 +1,23 @@
 uniform highp mat4 matrix;
-uniform lowp vec2 aspect;
+uniform lowp float opacity;
 
 attribute highp vec4 in_vertex;
 attribute mediump vec2 in_coord;
+attribute lowp vec4 in_color;
+attribute lowp vec4 in_radius;
+attribute mediump vec3 in_parameters;
 
 varying mediump vec2 coord;
+varying lowp vec4 color;
+varying lowp vec4 radius;
+varying mediump vec3 parameters;
 
 void main()
 {
     coord = in_coord;
+    color = in_color * opacity;
+    radius = in_radius;
+    parameters = in_parameters;
+
     gl_Position = matrix * in_vertex;
 }
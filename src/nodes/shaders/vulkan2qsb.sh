@@ -12,6 +12,9 @@ qsbcompile arcshadow-vulkan.frag
 qsbcompile boxshadow-vulkan.vert
 qsbcompile boxshadow-vulkan.frag
 
+qsbcompile boxdistancefield-vulkan.vert
+qsbcompile boxdistancefield-vulkan.frag
+
 qsbcompile gradientconic-vulkan.vert
 qsbcompile gradientconic-vulkan.frag
 